@@ -7,8 +7,259 @@
 
 #include "Blend.hpp"
 
+#include <cstring>
+
+#include "ColorSpace.hpp"
+
+// 정수 SIMD 경로. AVX2는 CMake 옵션 SSR_ENABLE_AVX2로 켰을 때만 컴파일된다 (docs/Build.md)
+#if defined(__AVX2__)
+#define SSR_BLEND_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSR_BLEND_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace ssr {
 
+const char* toString(BlendMode mode) {
+  switch (mode) {
+  case BlendMode::Opaque: return "Opaque";
+  case BlendMode::Alpha: return "Alpha";
+  case BlendMode::PremultipliedAlpha: return "PremultipliedAlpha";
+  case BlendMode::Additive: return "Additive";
+  case BlendMode::Multiply: return "Multiply";
+  }
+  return "Unknown";
+}
+
+namespace {
+
+// round(x / 255), x <= 255 * 255 범위에서 정확
+inline uint32_t div255(uint32_t x) {
+  return ((x + 128) * 257) >> 16;
+}
+
+inline uint32_t saturate255(uint32_t x) {
+  return x > 255 ? 255 : x;
+}
+
+// span의 기준이 되는 픽셀 하나 블렌딩. 채널 순서와 무관하고 알파만 24~31 비트로 구분
+uint32_t blendPixel(BlendMode mode, uint32_t src, uint32_t dst) {
+  const uint32_t sa = src >> 24;
+  const uint32_t inv = 255 - sa;
+
+  uint32_t out = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    const uint32_t s = (src >> shift) & 0xFF;
+    const uint32_t d = (dst >> shift) & 0xFF;
+    const bool alphaChannel = shift == 24;
+
+    uint32_t c = 0;
+    switch (mode) {
+    case BlendMode::Opaque:
+      c = s;
+      break;
+    case BlendMode::Alpha:
+      c = alphaChannel ? sa + div255(d * inv) : div255(s * sa + d * inv);
+      break;
+    case BlendMode::PremultipliedAlpha:
+      c = saturate255(s + div255(d * inv));
+      break;
+    case BlendMode::Additive:
+      c = alphaChannel ? d : saturate255(d + div255(s * sa));
+      break;
+    case BlendMode::Multiply:
+      c = alphaChannel ? d : saturate255(div255(s * d) + div255(d * inv));
+      break;
+    }
+    out |= c << shift;
+  }
+  return out;
+}
+
+// blendPixel의 선형 공간 버전. 색 채널은 12비트 선형으로 디코드해서 섞고 다시 sRGB로 인코드한다.
+// 알파는 원래 선형이므로 blendPixel과 같은 8비트 식
+uint32_t blendPixelSrgb(BlendMode mode, uint32_t src, uint32_t dst) {
+  constexpr uint32_t kMax = srgb::kLinearMax;
+  const uint32_t sa = src >> 24;
+  const uint32_t inv = 255 - sa;
+
+  uint32_t out = 0;
+  for (int shift = 0; shift < 24; shift += 8) {
+    const uint32_t s = srgb::decode12((uint8_t)(src >> shift));
+    const uint32_t d = srgb::decode12((uint8_t)(dst >> shift));
+
+    uint32_t c = 0;
+    switch (mode) {
+    case BlendMode::Opaque:
+      c = s;
+      break;
+    case BlendMode::Alpha:
+      c = (s * sa + d * inv + 127) / 255;
+      break;
+    case BlendMode::PremultipliedAlpha:
+      c = std::min(s + (d * inv + 127) / 255, kMax);
+      break;
+    case BlendMode::Additive:
+      c = std::min(d + (s * sa + 127) / 255, kMax);
+      break;
+    case BlendMode::Multiply:
+      c = std::min((s * d + kMax / 2) / kMax + (d * inv + 127) / 255, kMax);
+      break;
+    }
+    out |= (uint32_t)srgb::encode12(c) << shift;
+  }
+
+  const uint32_t da = dst >> 24;
+  uint32_t a = da;
+  if (mode == BlendMode::Opaque) {
+    a = sa;
+  } else if (mode == BlendMode::Alpha || mode == BlendMode::PremultipliedAlpha) {
+    a = saturate255(sa + div255(da * inv));
+  }
+  return out | (a << 24);
+}
+
+// 한 레지스터에 픽셀을 16비트 채널로 펼쳐서 계산한다. 알파 레인은 픽셀마다 3번째 16비트 레인.
+// ISA 구조체는 같은 커널 코드를 SSE2(4픽셀) / AVX2(8픽셀)로 찍어내기 위한 얇은 래퍼
+#if SSR_BLEND_SSE2
+struct Sse2 {
+  using V = __m128i;
+  static constexpr size_t kPixels = 4;
+
+  static V load(const uint32_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+  static void store(uint32_t* p, V v) { _mm_storeu_si128((__m128i*)p, v); }
+  static V zero() { return _mm_setzero_si128(); }
+  static V set16(short v) { return _mm_set1_epi16(v); }
+  static V alphaLanes(short v) { return _mm_set_epi16(v, 0, 0, 0, v, 0, 0, 0); }
+  static V unpackLo(V a) { return _mm_unpacklo_epi8(a, zero()); }
+  static V unpackHi(V a) { return _mm_unpackhi_epi8(a, zero()); }
+  static V pack(V lo, V hi) { return _mm_packus_epi16(lo, hi); }
+  static V add(V a, V b) { return _mm_add_epi16(a, b); }
+  static V sub(V a, V b) { return _mm_sub_epi16(a, b); }
+  static V mul(V a, V b) { return _mm_mullo_epi16(a, b); }
+  static V mulhi(V a, V b) { return _mm_mulhi_epu16(a, b); }
+  static V bitOr(V a, V b) { return _mm_or_si128(a, b); }
+  static V bitAndNot(V mask, V a) { return _mm_andnot_si128(mask, a); }
+  static V broadcastAlpha(V a) { return _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0xFF), 0xFF); }
+};
+#endif
+
+#if SSR_BLEND_AVX2
+struct Avx2 {
+  using V = __m256i;
+  static constexpr size_t kPixels = 8;
+
+  static V load(const uint32_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+  static void store(uint32_t* p, V v) { _mm256_storeu_si256((__m256i*)p, v); }
+  static V zero() { return _mm256_setzero_si256(); }
+  static V set16(short v) { return _mm256_set1_epi16(v); }
+  static V alphaLanes(short v) {
+    return _mm256_set_epi16(v, 0, 0, 0, v, 0, 0, 0, v, 0, 0, 0, v, 0, 0, 0);
+  }
+  // unpack / pack 모두 128비트 레인 단위라 순서가 그대로 복원된다
+  static V unpackLo(V a) { return _mm256_unpacklo_epi8(a, zero()); }
+  static V unpackHi(V a) { return _mm256_unpackhi_epi8(a, zero()); }
+  static V pack(V lo, V hi) { return _mm256_packus_epi16(lo, hi); }
+  static V add(V a, V b) { return _mm256_add_epi16(a, b); }
+  static V sub(V a, V b) { return _mm256_sub_epi16(a, b); }
+  static V mul(V a, V b) { return _mm256_mullo_epi16(a, b); }
+  static V mulhi(V a, V b) { return _mm256_mulhi_epu16(a, b); }
+  static V bitOr(V a, V b) { return _mm256_or_si256(a, b); }
+  static V bitAndNot(V mask, V a) { return _mm256_andnot_si256(mask, a); }
+  static V broadcastAlpha(V a) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(a, 0xFF), 0xFF);
+  }
+};
+#endif
+
+// 16비트 채널 2(SSE2) / 4(AVX2) 픽셀 블렌딩. 결과가 255를 넘으면 pack에서 포화된다
+// 모든 곱은 255 * 255 이하라 16비트 안에 들어간다
+template <typename Isa, BlendMode Mode>
+inline typename Isa::V blend16(typename Isa::V s, typename Isa::V d) {
+  using V = typename Isa::V;
+  const V sa = Isa::broadcastAlpha(s);
+  const V inv = Isa::sub(Isa::set16(255), sa);
+  const V alpha255 = Isa::alphaLanes(255);
+  const V alphaMask = Isa::alphaLanes(-1);
+
+  // ((x + 128) * 257) >> 16
+  auto div255 = [](V x) { return Isa::mulhi(Isa::add(x, Isa::set16(128)), Isa::set16(257)); };
+
+  if constexpr (Mode == BlendMode::Alpha) {
+    // 알파 레인은 src 쪽 계수를 255로 바꾸면 sa * 255 + da * inv 가 되어
+    // div255 후 sa + div255(da * inv)와 같아진다
+    return div255(Isa::add(Isa::mul(s, Isa::bitOr(sa, alpha255)), Isa::mul(d, inv)));
+  } else if constexpr (Mode == BlendMode::PremultipliedAlpha) {
+    return Isa::add(s, div255(Isa::mul(d, inv)));
+  } else if constexpr (Mode == BlendMode::Additive) {
+    // 알파 레인 계수 0 -> dst 알파 유지
+    return Isa::add(d, div255(Isa::mul(s, Isa::bitAndNot(alphaMask, sa))));
+  } else {
+    // Multiply: 알파 레인은 src를 255, inv를 0으로 바꿔 dst 알파 유지
+    const V product = div255(Isa::mul(Isa::bitOr(s, alpha255), d));
+    return Isa::add(product, div255(Isa::mul(d, Isa::bitAndNot(alphaMask, inv))));
+  }
+}
+
+// 처리한 픽셀 수를 반환. 남은 꼬리는 호출 측에서 더 좁은 경로로 처리
+template <typename Isa, BlendMode Mode>
+size_t blendSpanSimd(const uint32_t* src, uint32_t* dst, size_t count) {
+  size_t i = 0;
+  for (; i + Isa::kPixels <= count; i += Isa::kPixels) {
+    const typename Isa::V s = Isa::load(src + i);
+    const typename Isa::V d = Isa::load(dst + i);
+    const typename Isa::V lo = blend16<Isa, Mode>(Isa::unpackLo(s), Isa::unpackLo(d));
+    const typename Isa::V hi = blend16<Isa, Mode>(Isa::unpackHi(s), Isa::unpackHi(d));
+    Isa::store(dst + i, Isa::pack(lo, hi));
+  }
+  return i;
+}
+
+template <BlendMode Mode>
+void blendSpan(const uint32_t* src, uint32_t* dst, size_t count) {
+  size_t done = 0;
+#if SSR_BLEND_AVX2
+  done += blendSpanSimd<Avx2, Mode>(src + done, dst + done, count - done);
+#endif
+#if SSR_BLEND_SSE2
+  done += blendSpanSimd<Sse2, Mode>(src + done, dst + done, count - done);
+#endif
+  for (; done < count; ++done) {
+    dst[done] = blendPixel(Mode, src[done], dst[done]);
+  }
+}
+
+}  // namespace
+
+void Blend::span(BlendMode mode, const uint32_t* src, uint32_t* dst, size_t count) {
+  switch (mode) {
+  case BlendMode::Opaque: std::memmove(dst, src, count * sizeof(uint32_t)); break;
+  case BlendMode::Alpha: blendSpan<BlendMode::Alpha>(src, dst, count); break;
+  case BlendMode::PremultipliedAlpha: blendSpan<BlendMode::PremultipliedAlpha>(src, dst, count); break;
+  case BlendMode::Additive: blendSpan<BlendMode::Additive>(src, dst, count); break;
+  case BlendMode::Multiply: blendSpan<BlendMode::Multiply>(src, dst, count); break;
+  }
+}
+
+void Blend::spanReference(BlendMode mode, const uint32_t* src, uint32_t* dst, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = blendPixel(mode, src[i], dst[i]);
+  }
+}
+
+void Blend::spanSrgb(BlendMode mode, const uint32_t* src, uint32_t* dst, size_t count) {
+  if (mode == BlendMode::Opaque) {
+    std::memmove(dst, src, count * sizeof(uint32_t));
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = blendPixelSrgb(mode, src[i], dst[i]);
+  }
+}
+
 RGBAf Blend::convertToFloat(const RGBA& c) {
   // MSVC 사용 시 아래와 같이 구조체 초기화하는 기법은 C++20 이상부터 지원
   return RGBAf {
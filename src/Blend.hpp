@@ -8,11 +8,23 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
 #include "RGBA.hpp"
 
 namespace ssr {
 
+enum class BlendMode {
+  Opaque,              // dst = src
+  Alpha,               // Blend::alpha
+  PremultipliedAlpha,  // Blend::premultipliedAlpha
+  Additive,            // Blend::additive
+  Multiply,            // Blend::multiply
+};
+
+const char* toString(BlendMode mode);
+
 struct Blend {
 public:
 
@@ -41,6 +53,20 @@ static RGBA additive(const RGBA& src, const RGBA& dst);
 /// dstA = dstA
 static RGBA multiply(const RGBA& src, const RGBA& dst);
 
+/// 패킹된 32비트 픽셀 count개를 dst에 그대로 블렌딩 (알파는 24~31 비트, 나머지 세 채널은 순서 무관)
+/// 채널 연산은 8비트 정수, 나누기 255는 곱셈-시프트 ((x + 128) * 257) >> 16 으로 반올림한다.
+/// AVX2(8픽셀) / SSE2(4픽셀) 경로와 나머지 꼬리는 spanReference와 비트 단위로 같은 결과를 낸다.
+/// 위의 float 버전과는 반올림 방식이 달라 최대 1 차이가 날 수 있다.
+static void span(BlendMode mode, const uint32_t* src, uint32_t* dst, size_t count);
+
+/// span의 스칼라 기준 구현 (검증용)
+static void spanReference(BlendMode mode, const uint32_t* src, uint32_t* dst, size_t count);
+
+/// sRGB로 인코딩된 픽셀을 선형 공간에서 블렌딩 (ColorSpace.hpp의 테이블 사용)
+/// span과 같은 식을 색 채널만 12비트 선형으로 디코드해서 계산하고 다시 인코드한다.
+/// 테이블 조회가 픽셀마다 필요해서 SIMD 경로 없이 스칼라로 처리한다.
+static void spanSrgb(BlendMode mode, const uint32_t* src, uint32_t* dst, size_t count);
+
 }; // struct Blend
 
 }  // namespace ssr
@@ -0,0 +1,311 @@
+//------------------------------------------------------------------------------
+// File: Bloom.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "Bloom.hpp"
+
+#include <algorithm>
+
+#include "Blend.hpp"
+#include "ColorSpace.hpp"
+#include "SIMD.hpp"
+#include "ThreadPool.hpp"
+
+namespace ssr {
+
+namespace {
+
+// 피라미드는 절반 해상도부터라 행 묶음도 절반
+constexpr int kBandRows = ThreadPool::kRowBand / 2;
+// 5탭 이항 커널 [1 4 6 4 1] / 16
+constexpr float kWeight0 = 6.0f / 16.0f;
+constexpr float kWeight1 = 4.0f / 16.0f;
+constexpr float kWeight2 = 1.0f / 16.0f;
+
+inline int clampIndex(int i, int count) {
+  return i < 0 ? 0 : (i >= count ? count - 1 : i);
+}
+
+/// @brief 2배 확대할 때 목적지 i가 읽는 두 원본 인덱스. 가까운 쪽 0.75, 먼 쪽 0.25
+inline void upsampleTaps(int i, int srcCount, int& near, int& far) {
+  near = clampIndex(i >> 1, srcCount);
+  far = clampIndex((i & 1) ? (i >> 1) + 1 : (i >> 1) - 1, srcCount);
+}
+
+/// @brief 두 행을 0.75 / 0.25로 섞어서 out에 (Float4, stride까지)
+void lerpRows(const float* nearRow, const float* farRow, float* out, int stride) {
+  const Float4 wNear = Float4::splat(0.75f);
+  const Float4 wFar = Float4::splat(0.25f);
+  for (int x = 0; x < stride; x += 4) {
+    (Float4::load(nearRow + x) * wNear + Float4::load(farRow + x) * wFar).store(out + x);
+  }
+}
+
+}  // namespace
+
+void Bloom::resize(int width, int height) {
+  const int count = std::max(levelCount, 1);
+  if (m_width == width && m_height == height && m_builtLevelCount == count) {
+    return;
+  }
+  m_width = width;
+  m_height = height;
+  m_builtLevelCount = count;
+  m_levels.clear();
+
+  int w = std::max(width / 2, 1);
+  int h = std::max(height / 2, 1);
+  for (int i = 0; i < count; ++i) {
+    Level level;
+    level.width = w;
+    level.height = h;
+    level.stride = (w + 3) & ~3;
+    const size_t size = (size_t)level.stride * h;
+    level.r.assign(size, 0.0f);
+    level.g.assign(size, 0.0f);
+    level.b.assign(size, 0.0f);
+    level.tempR.assign(size, 0.0f);
+    level.tempG.assign(size, 0.0f);
+    level.tempB.assign(size, 0.0f);
+    m_levels.push_back(std::move(level));
+    // 블러 반경(2픽셀)보다 작아지면 더 줄여도 의미가 없다
+    if (w < 8 || h < 8) {
+      break;
+    }
+    w = std::max(w / 2, 1);
+    h = std::max(h / 2, 1);
+  }
+}
+
+void Bloom::extractRows(const uint32_t* pixels, int pitchInPixels, int y0, int y1, bool linear) {
+  Level& level = m_levels[0];
+  const float knee = std::max(softKnee, 0.0f);
+  const Float4 thresholdV = Float4::splat(threshold);
+  const Float4 kneeV = Float4::splat(knee);
+  const Float4 twoKnee = Float4::splat(2.0f * knee);
+  const Float4 invFourKnee = Float4::splat(1.0f / (4.0f * knee + 1e-5f));
+  const Float4 epsilon = Float4::splat(1e-5f);
+  const Float4 zero = Float4::splat(0.0f);
+
+  for (int y = y0; y < y1; ++y) {
+    const uint32_t* row0 = pixels + (size_t)clampIndex(2 * y, m_height) * pitchInPixels;
+    const uint32_t* row1 = pixels + (size_t)clampIndex(2 * y + 1, m_height) * pitchInPixels;
+    float* r = level.r.data() + (size_t)y * level.stride;
+    float* g = level.g.data() + (size_t)y * level.stride;
+    float* b = level.b.data() + (size_t)y * level.stride;
+
+    // 2x2 평균 (작업 공간에서)
+    for (int x = 0; x < level.width; ++x) {
+      const int x0 = clampIndex(2 * x, m_width);
+      const int x1 = clampIndex(2 * x + 1, m_width);
+      const uint32_t c[4] = { row0[x0], row0[x1], row1[x0], row1[x1] };
+      float sumR = 0.0f, sumG = 0.0f, sumB = 0.0f;
+      for (uint32_t p : c) {
+        sumR += srgb::toWorking(p >> 16, linear);
+        sumG += srgb::toWorking(p >> 8, linear);
+        sumB += srgb::toWorking(p, linear);
+      }
+      r[x] = sumR * 0.25f;
+      g[x] = sumG * 0.25f;
+      b[x] = sumB * 0.25f;
+    }
+
+    // 밝은 부분만 남김. threshold - knee부터 2차 곡선으로 이어지는 soft threshold
+    for (int x = 0; x < level.stride; x += 4) {
+      const Float4 cr = Float4::load(r + x), cg = Float4::load(g + x), cb = Float4::load(b + x);
+      const Float4 brightness = max(cr, max(cg, cb));
+      Float4 soft = min(max(brightness - thresholdV + kneeV, zero), twoKnee);
+      soft = soft * soft * invFourKnee;
+      const Float4 contribution = max(soft, brightness - thresholdV) / max(brightness, epsilon);
+      (cr * contribution).store(r + x);
+      (cg * contribution).store(g + x);
+      (cb * contribution).store(b + x);
+    }
+  }
+}
+
+void Bloom::downsampleRows(const Level& src, Level& dst, int y0, int y1) {
+  const float* srcPlanes[3] = { src.r.data(), src.g.data(), src.b.data() };
+  float* dstPlanes[3] = { dst.r.data(), dst.g.data(), dst.b.data() };
+  for (int y = y0; y < y1; ++y) {
+    const size_t row0 = (size_t)clampIndex(2 * y, src.height) * src.stride;
+    const size_t row1 = (size_t)clampIndex(2 * y + 1, src.height) * src.stride;
+    for (int c = 0; c < 3; ++c) {
+      const float* a = srcPlanes[c] + row0;
+      const float* b = srcPlanes[c] + row1;
+      float* out = dstPlanes[c] + (size_t)y * dst.stride;
+      for (int x = 0; x < dst.width; ++x) {
+        const int x0 = clampIndex(2 * x, src.width);
+        const int x1 = clampIndex(2 * x + 1, src.width);
+        out[x] = (a[x0] + a[x1] + b[x0] + b[x1]) * 0.25f;
+      }
+    }
+  }
+}
+
+void Bloom::blurHorizontalRows(Level& level, int y0, int y1) {
+  const float* srcPlanes[3] = { level.r.data(), level.g.data(), level.b.data() };
+  float* dstPlanes[3] = { level.tempR.data(), level.tempG.data(), level.tempB.data() };
+  const Float4 w0 = Float4::splat(kWeight0), w1 = Float4::splat(kWeight1), w2 = Float4::splat(kWeight2);
+  const int width = level.width;
+
+  auto blurScalar = [&](const float* src, float* dst, int x) {
+    dst[x] = src[x] * kWeight0 +
+             (src[clampIndex(x - 1, width)] + src[clampIndex(x + 1, width)]) * kWeight1 +
+             (src[clampIndex(x - 2, width)] + src[clampIndex(x + 2, width)]) * kWeight2;
+  };
+
+  for (int y = y0; y < y1; ++y) {
+    for (int c = 0; c < 3; ++c) {
+      const float* src = srcPlanes[c] + (size_t)y * level.stride;
+      float* dst = dstPlanes[c] + (size_t)y * level.stride;
+      // 양 끝 2픽셀은 가장자리를 반복해서 스칼라로, 안쪽은 x - 2 .. x + 5 를 읽는 Float4
+      int x = 0;
+      for (; x < std::min(2, width); ++x) {
+        blurScalar(src, dst, x);
+      }
+      for (; x + 6 <= width; x += 4) {
+        const Float4 center = Float4::load(src + x);
+        const Float4 near = Float4::load(src + x - 1) + Float4::load(src + x + 1);
+        const Float4 far = Float4::load(src + x - 2) + Float4::load(src + x + 2);
+        (center * w0 + near * w1 + far * w2).store(dst + x);
+      }
+      for (; x < width; ++x) {
+        blurScalar(src, dst, x);
+      }
+    }
+  }
+}
+
+void Bloom::blurVerticalRows(Level& level, int y0, int y1) {
+  const float* srcPlanes[3] = { level.tempR.data(), level.tempG.data(), level.tempB.data() };
+  float* dstPlanes[3] = { level.r.data(), level.g.data(), level.b.data() };
+  const Float4 w0 = Float4::splat(kWeight0), w1 = Float4::splat(kWeight1), w2 = Float4::splat(kWeight2);
+
+  for (int y = y0; y < y1; ++y) {
+    size_t rows[5];
+    for (int k = 0; k < 5; ++k) {
+      rows[k] = (size_t)clampIndex(y + k - 2, level.height) * level.stride;
+    }
+    for (int c = 0; c < 3; ++c) {
+      const float* src = srcPlanes[c];
+      float* dst = dstPlanes[c] + (size_t)y * level.stride;
+      for (int x = 0; x < level.stride; x += 4) {
+        const Float4 center = Float4::load(src + rows[2] + x);
+        const Float4 near = Float4::load(src + rows[1] + x) + Float4::load(src + rows[3] + x);
+        const Float4 far = Float4::load(src + rows[0] + x) + Float4::load(src + rows[4] + x);
+        (center * w0 + near * w1 + far * w2).store(dst + x);
+      }
+    }
+  }
+}
+
+void Bloom::upsampleAddRows(const Level& src, Level& dst, int y0, int y1) {
+  const float* srcPlanes[3] = { src.r.data(), src.g.data(), src.b.data() };
+  float* dstPlanes[3] = { dst.r.data(), dst.g.data(), dst.b.data() };
+  // dst의 임시 평면은 블러가 끝난 뒤라 비어 있으므로 세로 보간 결과를 행마다 잠깐 둔다
+  float* scratchPlanes[3] = { dst.tempR.data(), dst.tempG.data(), dst.tempB.data() };
+
+  for (int y = y0; y < y1; ++y) {
+    int nearY, farY;
+    upsampleTaps(y, src.height, nearY, farY);
+    for (int c = 0; c < 3; ++c) {
+      float* scratch = scratchPlanes[c] + (size_t)y * dst.stride;
+      lerpRows(srcPlanes[c] + (size_t)nearY * src.stride, srcPlanes[c] + (size_t)farY * src.stride,
+               scratch, src.stride);
+      float* out = dstPlanes[c] + (size_t)y * dst.stride;
+      for (int x = 0; x < dst.width; ++x) {
+        int nearX, farX;
+        upsampleTaps(x, src.width, nearX, farX);
+        out[x] += scratch[nearX] * 0.75f + scratch[farX] * 0.25f;
+      }
+    }
+  }
+}
+
+void Bloom::compositeRows(uint32_t* pixels, int pitchInPixels, int y0, int y1, bool linear) {
+  const Level& level = m_levels[0];
+  const float* planes[3] = { level.r.data(), level.g.data(), level.b.data() };
+  const float scale = intensity;
+  // 이보다 작으면 인코드 결과가 0 (반올림 전 첫 단계의 절반)
+  const float zeroLevel = linear ? 0.5f / (float)srgb::kLinearMax : 0.5f / 255.0f;
+
+  std::vector<float> scratch(3 * (size_t)level.stride);
+  std::vector<uint32_t> bloomRow(m_width);
+
+  for (int y = y0; y < y1; ++y) {
+    int nearY, farY;
+    upsampleTaps(y, level.height, nearY, farY);
+    for (int c = 0; c < 3; ++c) {
+      lerpRows(planes[c] + (size_t)nearY * level.stride, planes[c] + (size_t)farY * level.stride,
+               scratch.data() + (size_t)c * level.stride, level.stride);
+    }
+    const float* sr = scratch.data();
+    const float* sg = sr + level.stride;
+    const float* sb = sg + level.stride;
+    uint32_t* dst = pixels + (size_t)y * pitchInPixels;
+
+    // 알파 255의 가산 블렌딩: dst + bloom (채널마다 포화)
+    // 인코드해서 0이 되는 픽셀은 결과가 바뀌지 않으므로 0이 아닌 구간만 블렌딩한다
+    auto flush = [&](int begin, int end) {
+      if (begin >= end) {
+        return;
+      }
+      if (linear) {
+        Blend::spanSrgb(BlendMode::Additive, bloomRow.data() + begin, dst + begin, (size_t)(end - begin));
+      } else {
+        Blend::span(BlendMode::Additive, bloomRow.data() + begin, dst + begin, (size_t)(end - begin));
+      }
+    };
+    int runStart = 0;
+    for (int x = 0; x < m_width; ++x) {
+      int nearX, farX;
+      upsampleTaps(x, level.width, nearX, farX);
+      const float r = (sr[nearX] * 0.75f + sr[farX] * 0.25f) * scale;
+      const float g = (sg[nearX] * 0.75f + sg[farX] * 0.25f) * scale;
+      const float b = (sb[nearX] * 0.75f + sb[farX] * 0.25f) * scale;
+      const uint32_t rgb = std::max(r, std::max(g, b)) < zeroLevel
+                               ? 0u
+                               : (srgb::fromWorking(r, linear) << 16) | (srgb::fromWorking(g, linear) << 8) |
+                                     srgb::fromWorking(b, linear);
+      if (rgb == 0) {
+        flush(runStart, x);
+        runStart = x + 1;
+        continue;
+      }
+      bloomRow[x] = 0xFF000000u | rgb;
+    }
+    flush(runStart, m_width);
+  }
+}
+
+void Bloom::apply(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool) {
+  resize(width, height);
+  const bool linear = srgb::enabled();
+
+  pool.parallelFor(m_levels[0].height, kBandRows, [&](int y0, int y1) {
+    extractRows(pixels, pitchInPixels, y0, y1, linear);
+  });
+  for (size_t i = 1; i < m_levels.size(); ++i) {
+    pool.parallelFor(m_levels[i].height, kBandRows, [&](int y0, int y1) {
+      downsampleRows(m_levels[i - 1], m_levels[i], y0, y1);
+    });
+  }
+  for (Level& level : m_levels) {
+    pool.parallelFor(level.height, kBandRows, [&](int y0, int y1) { blurHorizontalRows(level, y0, y1); });
+    pool.parallelFor(level.height, kBandRows, [&](int y0, int y1) { blurVerticalRows(level, y0, y1); });
+  }
+  for (size_t i = m_levels.size() - 1; i > 0; --i) {
+    pool.parallelFor(m_levels[i - 1].height, kBandRows, [&](int y0, int y1) {
+      upsampleAddRows(m_levels[i], m_levels[i - 1], y0, y1);
+    });
+  }
+  pool.parallelFor(m_height, kBandRows * 2, [&](int y0, int y1) {
+    compositeRows(pixels, pitchInPixels, y0, y1, linear);
+  });
+}
+
+}  // namespace ssr
@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+// File: Bloom.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ssr {
+
+class ThreadPool;
+
+/// @brief 밝은 영역이 주변으로 번지는 블룸
+/// 1. 밝은 픽셀 추출 + 절반 해상도로 2x2 평균 (레벨 0)
+/// 2. 레벨마다 절반씩 줄인 피라미드 (2x2 평균)
+/// 3. 레벨마다 분리 가능한 5탭 이항 블러 (가로 / 세로, Float4)
+/// 4. 가장 작은 레벨부터 2배 이중선형 확대해서 한 단계 위 레벨에 더함
+/// 5. 레벨 0을 전체 해상도로 확대해서 Blend::span(Additive)로 프레임버퍼에 더함
+/// 작은 레벨의 좁은 블러가 원본 해상도에서는 넓은 블러가 되므로 전체 해상도 가우시안 없이 반경을 얻는다.
+class Bloom {
+public:
+  /// @brief pixels(0xAARRGGBB, 한 행 pitchInPixels개)에 블룸을 더한다
+  void apply(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool);
+
+  /// @brief 밝기(채널 최대값, 작업 공간)가 이 값을 넘는 부분만 번진다
+  float threshold = 0.8f;
+  /// @brief threshold 아래로 부드럽게 이어지는 구간 폭 (0이면 딱 잘림)
+  float softKnee = 0.3f;
+  /// @brief 더하는 세기
+  float intensity = 0.5f;
+  /// @brief 피라미드 단계 수 (절반 해상도 포함)
+  int levelCount = 5;
+
+private:
+  struct Level {
+    int width = 0;
+    int height = 0;
+    // 가로 Float4 연산이 끝까지 돌 수 있게 4의 배수로 올린 행 길이
+    int stride = 0;
+    std::vector<float> r, g, b;
+    std::vector<float> tempR, tempG, tempB;
+  };
+
+  void resize(int width, int height);
+  void extractRows(const uint32_t* pixels, int pitchInPixels, int y0, int y1, bool linear);
+  void downsampleRows(const Level& src, Level& dst, int y0, int y1);
+  void blurHorizontalRows(Level& level, int y0, int y1);
+  void blurVerticalRows(Level& level, int y0, int y1);
+  void upsampleAddRows(const Level& src, Level& dst, int y0, int y1);
+  void compositeRows(uint32_t* pixels, int pitchInPixels, int y0, int y1, bool linear);
+
+  int m_width = 0;
+  int m_height = 0;
+  // 피라미드를 만들 때의 levelCount. 바뀌면 다시 만든다 (작은 해상도에서는 levels가 더 적을 수 있음)
+  int m_builtLevelCount = 0;
+  std::vector<Level> m_levels;
+};
+
+}  // namespace ssr
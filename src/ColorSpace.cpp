@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// File: ColorSpace.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "ColorSpace.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace ssr {
+
+namespace srgb {
+
+namespace detail {
+float g_decode[256];
+uint16_t g_decode12[256];
+uint8_t g_encode[kEncodeSize];
+}  // namespace detail
+
+namespace {
+
+// IEC 61966-2-1 전달 함수
+double toLinear(double c) {
+  return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+}
+
+double toSrgb(double l) {
+  return l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+}
+
+bool enabledFromEnv() {
+  const char* env = std::getenv("SSR_SRGB");
+  return !(env != nullptr &&
+           (strcmp(env, "0") == 0 || strcmp(env, "false") == 0 || strcmp(env, "FALSE") == 0));
+}
+
+// 테이블은 정적 초기화 단계에서 한 번 채운다. 다른 정적 객체의 초기화에서는 쓰지 않는다
+struct TableInitializer {
+  TableInitializer() {
+    for (int i = 0; i < 256; ++i) {
+      const double l = toLinear(i / 255.0);
+      detail::g_decode[i] = (float)l;
+      detail::g_decode12[i] = (uint16_t)std::lround(l * kLinearMax);
+    }
+    for (int i = 0; i < kEncodeSize; ++i) {
+      detail::g_encode[i] = (uint8_t)std::lround(toSrgb((double)i / kLinearMax) * 255.0);
+    }
+  }
+};
+
+TableInitializer g_tableInitializer;
+
+// -1: 아직 환경 변수를 읽지 않음. 상수 초기화라서 다른 파일의 정적 초기화 순서와 무관
+int g_enabled = -1;
+
+}  // namespace
+
+bool enabled() {
+  if (g_enabled < 0) {
+    g_enabled = enabledFromEnv() ? 1 : 0;
+  }
+  return g_enabled != 0;
+}
+
+void setEnabled(bool enable) { g_enabled = enable ? 1 : 0; }
+
+}  // namespace srgb
+
+}  // namespace ssr
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+// File: ColorSpace.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+namespace ssr {
+
+/// @brief sRGB <-> 선형 변환 테이블
+/// 텍스처와 프레임버퍼의 8비트 값은 sRGB로 인코딩되어 있다고 보고, 라이팅과 블렌딩은 선형 공간에서 한다.
+/// 픽셀마다 pow를 부르지 않도록 디코드는 256개, 인코드는 선형 값을 12비트로 양자화한 4096개 테이블을 쓴다.
+/// 12비트 선형 -> 8비트 sRGB 기울기가 가장 큰 0 근처에서도 한 단계가 0.8 코드 이하라서
+/// decode12 -> encode12 왕복은 256개 코드 모두 원래 값으로 돌아온다.
+namespace srgb {
+
+constexpr int kEncodeSize = 4096;
+constexpr uint32_t kLinearMax = kEncodeSize - 1;
+
+namespace detail {
+extern float g_decode[256];
+extern uint16_t g_decode12[256];
+extern uint8_t g_encode[kEncodeSize];
+}  // namespace detail
+
+/// @brief 감마 보정 파이프라인 사용 여부. 기본값은 켜짐, 환경 변수 SSR_SRGB=0 으로 끌 수 있다
+bool enabled();
+void setEnabled(bool enable);
+
+/// @brief sRGB 8비트 -> 선형 [0, 1]
+inline float decode(uint8_t c) { return detail::g_decode[c]; }
+
+/// @brief sRGB 8비트 -> 선형 12비트 [0, 4095] (정수 블렌딩용)
+inline uint32_t decode12(uint8_t c) { return detail::g_decode12[c]; }
+
+/// @brief 선형 12비트 [0, 4095] -> sRGB 8비트
+inline uint8_t encode12(uint32_t linear) { return detail::g_encode[linear]; }
+
+/// @brief 선형 [0, 1] -> sRGB 8비트. 범위 밖은 잘라낸다
+inline uint8_t encode(float linear) {
+  linear = linear < 0.0f ? 0.0f : (linear > 1.0f ? 1.0f : linear);
+  return detail::g_encode[(uint32_t)(linear * (float)kLinearMax + 0.5f)];
+}
+
+/// @brief 후처리 작업 공간으로 (c의 하위 8비트). 감마 보정이 켜져 있으면(linear) 선형 [0, 1], 아니면 값 / 255 그대로
+inline float toWorking(uint32_t c, bool linear) {
+  return linear ? decode((uint8_t)c) : (float)(c & 0xFF) * (1.0f / 255.0f);
+}
+
+/// @brief 후처리 작업 공간 -> 8비트. 범위 밖은 잘라낸다
+inline uint32_t fromWorking(float v, bool linear) {
+  if (linear) {
+    return encode(v);
+  }
+  v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+  return (uint32_t)(v * 255.0f + 0.5f);
+}
+
+}  // namespace srgb
+
+}  // namespace ssr
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+// File: Depth.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "Depth.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace ssr {
+
+namespace depth {
+
+namespace {
+
+bool equalsIgnoreCase(const char* a, const char* b) {
+  for (; *a != '\0' && *b != '\0'; ++a, ++b) {
+    if (std::tolower((unsigned char)*a) != std::tolower((unsigned char)*b)) {
+      return false;
+    }
+  }
+  return *a == *b;
+}
+
+}  // namespace
+
+int bytesPerSample(DepthFormat format) {
+  return format == DepthFormat::Unorm16 ? 2 : 4;
+}
+
+void fill(DepthFormat format, void* plane, size_t index, size_t count, float z) {
+  switch (format) {
+  case DepthFormat::Unorm16: {
+    uint16_t* p = static_cast<uint16_t*>(plane) + index;
+    std::fill(p, p + count, (uint16_t)quantize(z, kUnorm16Max));
+    break;
+  }
+  case DepthFormat::Unorm24: {
+    uint32_t* p = static_cast<uint32_t*>(plane) + index;
+    std::fill(p, p + count, quantize(z, kUnorm24Max));
+    break;
+  }
+  case DepthFormat::Float32:
+  case DepthFormat::ReversedFloat32: {
+    float* p = static_cast<float*>(plane) + index;
+    std::fill(p, p + count, z);
+    break;
+  }
+  }
+}
+
+const char* toString(DepthFormat format) {
+  switch (format) {
+  case DepthFormat::Unorm16: return "Unorm16";
+  case DepthFormat::Unorm24: return "Unorm24";
+  case DepthFormat::Float32: return "Float32";
+  case DepthFormat::ReversedFloat32: return "ReversedFloat32";
+  }
+  return "Unknown";
+}
+
+const char* toString(DepthCompare compare) {
+  switch (compare) {
+  case DepthCompare::Never: return "Never";
+  case DepthCompare::Less: return "Less";
+  case DepthCompare::LessEqual: return "LessEqual";
+  case DepthCompare::Equal: return "Equal";
+  case DepthCompare::GreaterEqual: return "GreaterEqual";
+  case DepthCompare::Greater: return "Greater";
+  case DepthCompare::NotEqual: return "NotEqual";
+  case DepthCompare::Always: return "Always";
+  }
+  return "Unknown";
+}
+
+bool parse(const char* name, DepthFormat& out) {
+  static const struct {
+    const char* name;
+    DepthFormat format;
+  } kNames[] = {
+    { "unorm16", DepthFormat::Unorm16 },   { "d16", DepthFormat::Unorm16 },
+    { "unorm24", DepthFormat::Unorm24 },   { "d24", DepthFormat::Unorm24 },
+    { "float32", DepthFormat::Float32 },   { "float", DepthFormat::Float32 },
+    { "reversed", DepthFormat::ReversedFloat32 },
+  };
+  for (const auto& entry : kNames) {
+    if (equalsIgnoreCase(name, entry.name)) {
+      out = entry.format;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parse(const char* name, DepthCompare& out) {
+  static const struct {
+    const char* name;
+    DepthCompare compare;
+  } kNames[] = {
+    { "never", DepthCompare::Never },   { "less", DepthCompare::Less },
+    { "lequal", DepthCompare::LessEqual }, { "equal", DepthCompare::Equal },
+    { "gequal", DepthCompare::GreaterEqual }, { "greater", DepthCompare::Greater },
+    { "notequal", DepthCompare::NotEqual }, { "always", DepthCompare::Always },
+  };
+  for (const auto& entry : kNames) {
+    if (equalsIgnoreCase(name, entry.name)) {
+      out = entry.compare;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace depth
+
+}  // namespace ssr
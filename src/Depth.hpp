@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+// File: Depth.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SIMD.hpp"
+
+namespace ssr {
+
+/// @brief 깊이 평면의 저장 형식. 래스터라이저가 보간한 NDC 깊이(z/w)를 어떻게 담는지
+enum class DepthFormat {
+  /// 16비트 정규화 정수. 샘플당 2바이트라 깊이 읽기 / 쓰기 대역폭이 절반. 깊이 범위가 좁은 씬용
+  Unorm16,
+  /// 24비트 정규화 정수. 32비트 워드의 아래 24비트에 담는다 (위 8비트는 비움, D24S8과 같은 배치)
+  Unorm24,
+  /// 32비트 float. near = 0, far = 1
+  Float32,
+  /// 32비트 float, 뒤집은 깊이. near = 1, far = 0 (setupReversedPerspectiveProjectionMatrix와 함께)
+  /// float 지수가 0 근처에 몰린 정밀도를 먼 쪽이 쓰게 되어 넓은 야외 씬에서 z-fighting이 줄어든다
+  ReversedFloat32,
+};
+
+/// @brief 깊이 테스트 함수. 들어오는 깊이 (op) 저장된 깊이가 참이면 통과
+enum class DepthCompare {
+  Never,
+  Less,
+  LessEqual,
+  Equal,
+  GreaterEqual,
+  Greater,
+  NotEqual,
+  Always,
+};
+
+namespace depth {
+
+constexpr uint32_t kUnorm16Max = 0xFFFF;
+constexpr uint32_t kUnorm24Max = 0xFFFFFF;
+
+int bytesPerSample(DepthFormat format);
+
+/// @brief 뒤집은 깊이(가까울수록 큰 값)인지
+inline bool isReversed(DepthFormat format) { return format == DepthFormat::ReversedFloat32; }
+inline bool isFloat(DepthFormat format) {
+  return format == DepthFormat::Float32 || format == DepthFormat::ReversedFloat32;
+}
+
+/// @brief 가장 먼 깊이 (clear 값). 뒤집은 형식이면 0
+inline float farValue(DepthFormat format) { return isReversed(format) ? 0.0f : 1.0f; }
+
+/// @brief 형식에 맞는 기본 비교 함수 (Less, 뒤집은 형식은 Greater)
+inline DepthCompare defaultCompare(DepthFormat format) {
+  return isReversed(format) ? DepthCompare::Greater : DepthCompare::Less;
+}
+
+/// @brief NDC 깊이를 정규화 정수로 (범위 밖은 잘라냄, 반올림)
+/// 24비트 최대값 근처는 + 0.5가 2^24로 올림될 수 있어 한 번 더 자른다. Float4 판과 결과가 같다
+inline uint32_t quantize(float z, uint32_t maxValue) {
+  const float clamped = z < 0.0f ? 0.0f : (z > 1.0f ? 1.0f : z);
+  const uint32_t q = (uint32_t)(clamped * (float)maxValue + 0.5f);
+  return q < maxValue ? q : maxValue;
+}
+
+/// @brief quantize의 Float4 판. 결과는 정수 값을 담은 float (24비트까지 정확)
+inline Float4 quantize(Float4 z, float maxValue) {
+  const Float4 clamped = min(max(z, Float4::splat(0.0f)), Float4::splat(1.0f));
+  return min(truncate(clamped * Float4::splat(maxValue) + Float4::splat(0.5f)), Float4::splat(maxValue));
+}
+
+/// @brief 샘플 비트마스크로 비교 결과 만들기
+/// less / greater: 들어오는 깊이가 저장된 값보다 작은 / 큰 샘플 (같은 샘플은 둘 다 0)
+/// all: 판정할 샘플 전체. 비교 연산이 무엇이든 크기 비교 두 번으로 끝나므로 SIMD 경로도 그대로 쓴다
+inline uint32_t passMask(DepthCompare compare, uint32_t less, uint32_t greater, uint32_t all) {
+  switch (compare) {
+  case DepthCompare::Never: return 0;
+  case DepthCompare::Less: return less;
+  case DepthCompare::LessEqual: return all & ~greater;
+  case DepthCompare::Equal: return all & ~(less | greater);
+  case DepthCompare::GreaterEqual: return all & ~less;
+  case DepthCompare::Greater: return greater;
+  case DepthCompare::NotEqual: return less | greater;
+  case DepthCompare::Always: return all;
+  }
+  return 0;
+}
+
+/// @brief 깊이 테스트에서 비교하는 저장 값. float 형식은 NDC 깊이, 정규화 정수 형식은 정수 값 그대로
+/// (들어오는 깊이도 quantize한 정수를 float로 바꿔 비교하므로 모든 형식이 float 비교 한 가지로 끝난다)
+inline float readKey(DepthFormat format, const void* plane, size_t index) {
+  switch (format) {
+  case DepthFormat::Unorm16: return (float)static_cast<const uint16_t*>(plane)[index];
+  case DepthFormat::Unorm24: return (float)(static_cast<const uint32_t*>(plane)[index] & kUnorm24Max);
+  case DepthFormat::Float32:
+  case DepthFormat::ReversedFloat32: return static_cast<const float*>(plane)[index];
+  }
+  return 0.0f;
+}
+
+/// @brief 저장된 샘플 하나를 NDC 깊이로
+inline float read(DepthFormat format, const void* plane, size_t index) {
+  switch (format) {
+  case DepthFormat::Unorm16:
+    return static_cast<const uint16_t*>(plane)[index] * (1.0f / (float)kUnorm16Max);
+  case DepthFormat::Unorm24:
+    return (static_cast<const uint32_t*>(plane)[index] & kUnorm24Max) * (1.0f / (float)kUnorm24Max);
+  case DepthFormat::Float32:
+  case DepthFormat::ReversedFloat32:
+    return static_cast<const float*>(plane)[index];
+  }
+  return 0.0f;
+}
+
+/// @brief NDC 깊이 z로 샘플 count개를 채운다
+void fill(DepthFormat format, void* plane, size_t index, size_t count, float z);
+
+const char* toString(DepthFormat format);
+const char* toString(DepthCompare compare);
+
+/// @brief "unorm16", "unorm24", "float32", "reversed" (대소문자 무시). 모르는 이름이면 false
+bool parse(const char* name, DepthFormat& out);
+/// @brief "never", "less", "lequal", "equal", "gequal", "greater", "notequal", "always"
+bool parse(const char* name, DepthCompare& out);
+
+}  // namespace depth
+
+}  // namespace ssr
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+// File: FastMath.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include "SIMD.hpp"
+
+namespace ssr {
+
+/// @brief 핫 패스(정점 변환, 픽셀 라이팅)용 근사 수학 함수
+/// 모두 Float4 기반이며 스칼라 버전은 레인 0만 사용한다.
+/// 오차는 float 전 범위가 아니라 렌더러가 실제로 넣는 입력 범위에서 측정한 값이다.
+namespace fastmath {
+
+constexpr float kPi = 3.14159265358979f;
+constexpr float kTwoPi = 6.28318530717959f;
+constexpr float kHalfPi = 1.57079632679490f;
+constexpr float kDegToRad = kPi / 180.0f;
+
+/// @brief 1/x. 하드웨어 추정값 + Newton 1회
+/// 상대 오차 < 2.5e-7 (정규화 수 x > 0)
+inline Float4 rcp(Float4 x) {
+  Float4 r = rcpEstimate(x);
+  // r' = r * (2 - x * r)
+  return r * (Float4::splat(2.0f) - x * r);
+}
+
+/// @brief 1/sqrt(x). 하드웨어 추정값 + Newton 1회
+/// 상대 오차 < 3.0e-7 (정규화 수 x > 0). x = 0 이면 Newton 단계에서 0 * inf가 되어 NaN이므로
+/// 0이 될 수 있는 입력은 호출하는 쪽에서 작은 양수로 자른다 (lighting::normalize처럼)
+inline Float4 rsqrt(Float4 x) {
+  Float4 r = rsqrtEstimate(x);
+  // r' = r * (1.5 - 0.5 * x * r^2)
+  return r * (Float4::splat(1.5f) - Float4::splat(0.5f) * x * r * r);
+}
+
+namespace detail {
+
+// x - round(x / 2pi) * 2pi. 결과는 [-pi, pi]
+// 2pi를 상위(가수 8비트) / 하위 두 상수로 나눠 빼서 큰 x에서도 반올림 오차를 줄인다 (Cody-Waite)
+inline Float4 reduceTwoPi(Float4 x) {
+  const Float4 half = Float4::splat(0.5f);
+  const Float4 zero = Float4::splat(0.0f);
+  Float4 q = x * Float4::splat(1.0f / kTwoPi);
+  q = truncate(q + select(greaterThan(q, zero), half, zero - half));
+  x = x - q * Float4::splat(6.28125f);
+  return x - q * Float4::splat(1.93530717958647e-3f);
+}
+
+// 범위를 줄인 x ([-pi, 3pi/2])의 sin. [-pi/2, pi/2]로 반사해서 11차 홀수 다항식
+inline Float4 sinReduced(Float4 x) {
+  const Float4 zero = Float4::splat(0.0f);
+  // sin(x) = sin(pi - x) 로 [-pi/2, pi/2] 안으로 반사
+  const Float4 pi = Float4::splat(kPi);
+  x = select(greaterThan(x, Float4::splat(kHalfPi)), pi - x, x);
+  x = select(greaterThan(Float4::splat(-kHalfPi), x), zero - pi - x, x);
+
+  const Float4 x2 = x * x;
+  Float4 p = Float4::splat(-2.5052108e-8f);
+  p = p * x2 + Float4::splat(2.7557319e-6f);
+  p = p * x2 + Float4::splat(-1.9841270e-4f);
+  p = p * x2 + Float4::splat(8.3333333e-3f);
+  p = p * x2 + Float4::splat(-1.6666667e-1f);
+  return x + x * x2 * p;
+}
+
+}  // namespace detail
+
+/// @brief sin(x). [-pi, pi]로 접은 뒤 [-pi/2, pi/2]로 반사해서 11차 홀수 다항식
+/// |x| <= 1e4 에서 절대 오차 < 3.0e-7
+inline Float4 sin(Float4 x) {
+  return detail::sinReduced(detail::reduceTwoPi(x));
+}
+
+/// @brief cos(x) = sin(x + pi/2). pi/2는 범위를 줄인 뒤에 더한다 (큰 x에 먼저 더하면 float 반올림으로 정밀도를 잃음)
+/// |x| <= 1e4 에서 절대 오차 < 3.0e-7
+inline Float4 cos(Float4 x) {
+  return detail::sinReduced(detail::reduceTwoPi(x) + Float4::splat(kHalfPi));
+}
+
+/// @brief log2(x), x > 0 정규화 수
+/// 가수를 [sqrt(0.5), sqrt(2))로 맞추고 t = (m - 1) / (m + 1)의 atanh 급수 4항
+/// 절대 오차 < 3.0e-7
+inline Float4 log2(Float4 x) {
+  Float4 exponent, mantissa;
+  splitExponent(x, exponent, mantissa);
+
+  const Float4 one = Float4::splat(1.0f);
+  Float4 big = greaterThan(mantissa, Float4::splat(1.41421356f));
+  mantissa = select(big, mantissa * Float4::splat(0.5f), mantissa);
+  exponent = select(big, exponent + one, exponent);
+
+  const Float4 t = (mantissa - one) * rcp(mantissa + one);
+  const Float4 t2 = t * t;
+  Float4 p = Float4::splat(1.0f / 7.0f);
+  p = p * t2 + Float4::splat(1.0f / 5.0f);
+  p = p * t2 + Float4::splat(1.0f / 3.0f);
+  p = p * t2 + one;
+  // 2 / ln(2)
+  return exponent + t * p * Float4::splat(2.88539008f);
+}
+
+/// @brief 2^x. 입력은 [-126, 127]로 자른다
+/// 2^floor(x)는 지수 비트로 만들고 소수부는 5차 최소제곱 다항식
+/// 상대 오차 < 2.0e-7
+inline Float4 exp2(Float4 x) {
+  x = min(max(x, Float4::splat(-126.0f)), Float4::splat(127.0f));
+
+  // floor: truncate는 음수에서 올림이 되므로 보정
+  Float4 i = truncate(x);
+  i = select(greaterThan(i, x), i - Float4::splat(1.0f), i);
+  const Float4 f = x - i;
+
+  Float4 p = Float4::splat(1.87623146e-3f);
+  p = p * f + Float4::splat(8.99258766e-3f);
+  p = p * f + Float4::splat(5.58236014e-2f);
+  p = p * f + Float4::splat(2.40154531e-1f);
+  p = p * f + Float4::splat(6.93152968e-1f);
+  p = p * f + Float4::splat(9.99999927e-1f);
+  return p * exp2Integer(i);
+}
+
+/// @brief base^exponent = 2^(exponent * log2(base)). base <= 0 이면 0
+/// 정반사 하이라이트용: base [1e-4, 1], exponent [1, 256]에서 상대 오차 < 3.0e-5
+/// (log2 오차가 exponent 배로 커지므로 exponent에 비례)
+inline Float4 pow(Float4 base, float exponent) {
+  const Float4 zero = Float4::splat(0.0f);
+  const Float4 positive = greaterThan(base, zero);
+  // 0 이하 레인은 log2에 넣지 않도록 1로 바꿨다가 마지막에 0으로 덮음
+  Float4 safe = select(positive, base, Float4::splat(1.0f));
+  return select(positive, exp2(log2(safe) * Float4::splat(exponent)), zero);
+}
+
+// 스칼라 버전 (행렬 구성, 정점 단위 계산용)
+
+inline float rsqrt(float x) { return lane0(rsqrt(Float4::splat(x))); }
+
+inline float sin(float x) { return lane0(sin(Float4::splat(x))); }
+
+inline float cos(float x) { return lane0(cos(Float4::splat(x))); }
+
+/// @brief sin, cos를 한 번의 범위 축소와 다항식 평가로 함께 계산 (레인 0 = sin, 레인 1 = cos)
+inline void sincos(float x, float& outSin, float& outCos) {
+  static const float kPhase[4] = { 0.0f, kHalfPi, 0.0f, 0.0f };
+  float out[4];
+  detail::sinReduced(detail::reduceTwoPi(Float4::splat(x)) + Float4::load(kPhase)).store(out);
+  outSin = out[0];
+  outCos = out[1];
+}
+
+}  // namespace fastmath
+
+}  // namespace ssr
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+// File: FrameBuffer.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "FrameBuffer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "Multisample.hpp"
+#include "SIMD.hpp"
+
+namespace ssr {
+
+const char* toString(FrameBuffer::Layout layout) {
+  switch (layout) {
+  case FrameBuffer::Layout::Linear: return "Linear";
+  case FrameBuffer::Layout::Tiled: return "Tiled";
+  }
+  return "Unknown";
+}
+
+void FrameBuffer::resize(int width, int height, int samples, Layout layout, DepthFormat depthFormat) {
+  if (m_width == width && m_height == height && m_samples == samples && m_layout == layout &&
+      m_depthFormat == depthFormat) {
+    return;
+  }
+  m_width = width;
+  m_height = height;
+  m_samples = samples;
+  m_layout = layout;
+  m_depthFormat = depthFormat;
+  m_tilesX = (width + kTileMask) >> kTileShift;
+  m_tilesY = (height + kTileMask) >> kTileShift;
+
+  // 타일 배치는 오른쪽 / 아래쪽 가장자리 타일도 8x8 전체를 잡아 둔다 (인덱스 계산에 분기가 없도록)
+  const size_t pixelCount = layout == Layout::Tiled ? (size_t)m_tilesX * m_tilesY * kTilePixels
+                                                    : (size_t)width * height;
+  m_color.allocate(pixelCount * samples);
+  m_depth.allocate(pixelCount * samples * depth::bytesPerSample(depthFormat));
+  m_output.allocate((size_t)width * height);
+  // 새 평면은 내용이 없으므로 전부 지울 예정으로 둔다
+  m_pendingClear.assign((size_t)m_tilesX * m_tilesY, 1);
+  m_hiZ.assign((size_t)m_tilesX * m_tilesY, depth::isReversed(depthFormat) ? 0.0f : 1.0f);
+}
+
+void FrameBuffer::clear(uint32_t color, float depth) {
+  m_clearColor = color;
+  m_clearDepth = depth;
+  std::fill(m_pendingClear.begin(), m_pendingClear.end(), (uint8_t)1);
+  // 지운 타일의 모든 샘플이 지울 깊이이므로 그것이 가장 먼 깊이
+  float clearKey = depth;
+  if (m_depthFormat == DepthFormat::Unorm16) {
+    clearKey = (float)depth::quantize(depth, depth::kUnorm16Max);
+  } else if (m_depthFormat == DepthFormat::Unorm24) {
+    clearKey = (float)depth::quantize(depth, depth::kUnorm24Max);
+  }
+  std::fill(m_hiZ.begin(), m_hiZ.end(), clearKey);
+}
+
+int FrameBuffer::preparedTileCount() const {
+  return (int)std::count(m_pendingClear.begin(), m_pendingClear.end(), (uint8_t)0);
+}
+
+void FrameBuffer::fillTile(int tileX, int tileY) {
+  const int x0 = tileX << kTileShift;
+  const int y0 = tileY << kTileShift;
+  if (m_layout == Layout::Tiled) {
+    // 가장자리 타일의 화면 밖 부분까지 한 번에 (타일 전체가 연속)
+    const size_t begin = sampleIndex(x0, y0);
+    const size_t count = (size_t)kTilePixels * m_samples;
+    std::fill(m_color.data() + begin, m_color.data() + begin + count, m_clearColor);
+    depth::fill(m_depthFormat, m_depth.data(), begin, count, m_clearDepth);
+    return;
+  }
+  const int y1 = std::min(y0 + kTileSize, m_height);
+  const size_t count = (size_t)std::min(kTileSize, m_width - x0) * m_samples;
+  for (int y = y0; y < y1; ++y) {
+    const size_t begin = sampleIndex(x0, y);
+    std::fill(m_color.data() + begin, m_color.data() + begin + count, m_clearColor);
+    depth::fill(m_depthFormat, m_depth.data(), begin, count, m_clearDepth);
+  }
+}
+
+void FrameBuffer::updateHiZ(int tileX, int tileY) {
+  const int x0 = tileX << kTileShift;
+  const int y0 = tileY << kTileShift;
+  const int y1 = std::min(y0 + kTileSize, m_height);
+  const size_t count = (size_t)std::min(kTileSize, m_width - x0) * m_samples;
+  const bool reversed = depth::isReversed(m_depthFormat);
+  float farthest = reversed ? std::numeric_limits<float>::max() : -std::numeric_limits<float>::max();
+  // 한 행의 샘플은 어느 배치든 연속. float 형식은 그대로, 정수 형식은 정수 값으로 (readKey와 같은 단위)
+  for (int y = y0; y < y1; ++y) {
+    const size_t begin = sampleIndex(x0, y);
+    switch (m_depthFormat) {
+    case DepthFormat::Unorm16: {
+      const uint16_t* p = reinterpret_cast<const uint16_t*>(m_depth.data()) + begin;
+      farthest = std::max(farthest, (float)*std::max_element(p, p + count));
+      break;
+    }
+    case DepthFormat::Unorm24: {
+      const uint32_t* p = reinterpret_cast<const uint32_t*>(m_depth.data()) + begin;
+      uint32_t m = 0;
+      for (size_t i = 0; i < count; ++i) {
+        m = std::max(m, p[i] & depth::kUnorm24Max);
+      }
+      farthest = std::max(farthest, (float)m);
+      break;
+    }
+    case DepthFormat::Float32:
+    case DepthFormat::ReversedFloat32: {
+      const float* p = reinterpret_cast<const float*>(m_depth.data()) + begin;
+      Float4 acc = Float4::splat(farthest);
+      size_t i = 0;
+      for (; i + 4 <= count; i += 4) {
+        acc = reversed ? min(acc, Float4::load(p + i)) : max(acc, Float4::load(p + i));
+      }
+      float lanes[4];
+      acc.store(lanes);
+      for (; i < count; ++i) {
+        lanes[0] = reversed ? std::min(lanes[0], p[i]) : std::max(lanes[0], p[i]);
+      }
+      farthest = reversed ? std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]))
+                          : std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+      break;
+    }
+    }
+  }
+  m_hiZ[(size_t)tileY * m_tilesX + tileX] = farthest;
+}
+
+float FrameBuffer::nearestDepth(int x, int y) const {
+  if (isPendingClear(x, y)) {
+    return m_clearDepth;
+  }
+  const size_t index = sampleIndex(x, y);
+  float z = depth::read(m_depthFormat, m_depth.data(), index);
+  const bool reversed = depth::isReversed(m_depthFormat);
+  for (int s = 1; s < m_samples; ++s) {
+    const float sz = depth::read(m_depthFormat, m_depth.data(), index + s);
+    z = reversed ? std::max(z, sz) : std::min(z, sz);
+  }
+  return z;
+}
+
+void FrameBuffer::resolve(bool linear) {
+  uint32_t* out = output();
+  const size_t pitch = (size_t)outputPitch();
+
+  // 타일의 한 행(최대 8픽셀)은 어느 배치든 샘플 평면에서 연속이므로 행 단위로 리졸브하면서 제자리로 옮긴다
+  // 한 번도 건드리지 않은 타일은 모든 샘플이 지울 색이므로 평균 없이 채운다
+  for (int tileY = 0; tileY < m_tilesY; ++tileY) {
+    const int y0 = tileY << kTileShift;
+    const int y1 = std::min(y0 + kTileSize, m_height);
+    for (int tileX = 0; tileX < m_tilesX; ++tileX) {
+      const int x0 = tileX << kTileShift;
+      const int count = std::min(kTileSize, m_width - x0);
+      const bool pending = m_pendingClear[(size_t)tileY * m_tilesX + tileX] != 0;
+      for (int y = y0; y < y1; ++y) {
+        uint32_t* dst = out + (size_t)y * pitch + x0;
+        if (pending) {
+          std::fill(dst, dst + count, m_clearColor);
+        } else {
+          msaa::resolve(m_color.data() + sampleIndex(x0, y), m_samples, dst, (size_t)count, linear);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace ssr
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+// File: FrameBuffer.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "Depth.hpp"
+
+namespace ssr {
+
+/// @brief 캐시 라인(64바이트) 정렬 배열. 원소는 초기화하지 않는다 (uint32_t, float 같은 POD 전용)
+template <typename T>
+class AlignedArray {
+public:
+  static constexpr size_t kAlignment = 64;
+
+  void allocate(size_t count) {
+    if (count == m_size) {
+      return;
+    }
+    m_data.reset(count > 0 ? static_cast<T*>(::operator new[](count * sizeof(T), std::align_val_t(kAlignment)))
+                           : nullptr);
+    m_size = count;
+  }
+
+  T* data() { return m_data.get(); }
+  const T* data() const { return m_data.get(); }
+  size_t size() const { return m_size; }
+  T& operator[](size_t i) { return m_data[i]; }
+  const T& operator[](size_t i) const { return m_data[i]; }
+
+private:
+  struct Deleter {
+    void operator()(T* p) const { ::operator delete[](p, std::align_val_t(kAlignment)); }
+  };
+
+  std::unique_ptr<T[], Deleter> m_data;
+  size_t m_size = 0;
+};
+
+/// @brief 래스터라이저가 그리는 렌더 타깃
+/// 샘플 색 / 샘플 깊이 평면과, 리졸브 결과(1x, 행 우선)를 담는 출력 평면을 가진다. 모든 평면은 64바이트 정렬.
+/// 샘플 평면의 배치:
+///   Linear: 행 우선. 픽셀 (x, y)의 샘플 s = (y * width + x) * samples + s
+///   Tiled:  8x8 타일 우선. 한 타일의 픽셀(과 샘플)이 연속이라 타일 하나가 256 * samples 바이트,
+///           캐시 라인 경계에서 시작한다. 타일 단위로 그리는 래스터라이저가 한 타일 안에서만 메모리를 오가고
+///           다른 타일을 맡은 스레드와 캐시 라인을 공유하지 않는다.
+/// 깊이 평면의 원소 형식은 DepthFormat이 정한다 (Unorm16이면 샘플당 2바이트, 나머지는 4바이트).
+/// 어느 배치든 한 픽셀의 샘플은 붙어 있으므로 sampleIndex로 첫 샘플 위치만 구하면 된다.
+/// 출력 평면은 resolve가 MSAA 평균과 타일 해제(detile)를 한 번에 해서 채운다.
+/// bindOutput으로 외부 메모리(창 표면, 트리플 버퍼 프레임)를 출력 평면 대신 쓸 수 있다. 행 간격은 그 메모리의 pitch.
+/// 합성과 후처리가 다시 읽으므로 읽을 수 있는 시스템 메모리여야 한다 (잠근 화면 텍스처는 PostProcessChain::run의 destination).
+/// clear는 8x8 타일마다 "지울 예정" 플래그만 세운다. 실제 값은 타일을 처음 건드릴 때(prepareTile) 채우고,
+/// 끝까지 건드리지 않은 타일은 resolve가 샘플을 읽지 않고 지울 색으로 바로 출력한다.
+/// 타일마다 가장 먼 깊이(계층 깊이, HiZ)를 따로 둔다. 래스터라이저가 타일에 깊이를 쓴 뒤 updateHiZ로 다시 구하고,
+/// 삼각형의 가장 가까운 깊이가 이보다 멀면 그 타일의 픽셀은 하나도 보지 않고 건너뛴다.
+class FrameBuffer {
+public:
+  enum class Layout {
+    Linear,
+    Tiled,
+  };
+
+  static constexpr int kTileShift = 3;
+  static constexpr int kTileSize = 1 << kTileShift;
+  static constexpr int kTileMask = kTileSize - 1;
+  static constexpr int kTilePixels = kTileSize * kTileSize;
+
+  /// @brief 크기 / 샘플 수 / 배치 / 깊이 형식이 바뀔 때만 다시 할당한다. 내용은 정의되지 않으므로 clear가 필요
+  void resize(int width, int height, int samples, Layout layout, DepthFormat depthFormat = DepthFormat::Float32);
+
+  /// @brief 모든 타일을 지울 예정으로 표시 (타일 수만큼의 플래그만 쓴다)
+  /// @param depth NDC 깊이. 채울 때 깊이 형식에 맞게 양자화된다
+  void clear(uint32_t color, float depth);
+
+  /// @brief 타일의 샘플을 읽거나 쓰기 전에 호출. 지울 예정인 타일이면 이때 지울 값으로 채운다
+  void prepareTile(int tileX, int tileY) {
+    uint8_t& pending = m_pendingClear[(size_t)tileY * m_tilesX + tileX];
+    if (pending != 0) {
+      fillTile(tileX, tileY);
+      pending = 0;
+    }
+  }
+
+  /// @brief 픽셀 (x, y)가 속한 타일이 아직 지울 예정인지 (샘플 값이 의미 없음)
+  bool isPendingClear(int x, int y) const {
+    return m_pendingClear[(size_t)(y >> kTileShift) * m_tilesX + (x >> kTileShift)] != 0;
+  }
+
+  uint32_t clearColor() const { return m_clearColor; }
+  float clearDepth() const { return m_clearDepth; }
+
+  /// @brief 픽셀 (x, y)의 샘플 중 가장 가까운 깊이 (NDC). 지울 예정인 타일이면 지울 깊이
+  float nearestDepth(int x, int y) const;
+
+  /// @brief 타일의 가장 먼 깊이. 깊이 테스트에서 비교하는 값(depth::readKey)과 같은 단위이고
+  /// 뒤집은 형식이면 최소값이다. 실제 가장 먼 값보다 가깝지 않음이 보장된다 (보수적)
+  float hiZ(int tileX, int tileY) const { return m_hiZ[(size_t)tileY * m_tilesX + tileX]; }
+
+  /// @brief 타일의 화면 안 샘플을 모두 읽어서 가장 먼 깊이를 다시 구한다. 깊이를 쓴 타일마다 호출
+  void updateHiZ(int tileX, int tileY);
+
+  /// @brief 마지막 clear 이후 실제로 채운 타일 수
+  int preparedTileCount() const;
+
+  /// @brief 샘플 평면을 출력 평면으로 (MSAA 평균 + 타일 해제)
+  /// @param linear 색 채널을 선형 공간에서 평균 (sRGB 파이프라인)
+  void resolve(bool linear);
+
+  int width() const { return m_width; }
+  int height() const { return m_height; }
+  int samples() const { return m_samples; }
+  Layout layout() const { return m_layout; }
+  DepthFormat depthFormat() const { return m_depthFormat; }
+  int tilesX() const { return m_tilesX; }
+  int tilesY() const { return m_tilesY; }
+
+  /// @brief 픽셀 (x, y)의 첫 샘플 위치 (색 / 깊이 평면 공통)
+  size_t sampleIndex(int x, int y) const {
+    if (m_layout == Layout::Linear) {
+      return ((size_t)y * m_width + x) * m_samples;
+    }
+    const size_t tile = (size_t)(y >> kTileShift) * m_tilesX + (size_t)(x >> kTileShift);
+    const size_t inTile = (size_t)(((y & kTileMask) << kTileShift) | (x & kTileMask));
+    return ((tile << (2 * kTileShift)) | inTile) * m_samples;
+  }
+
+  uint32_t* colorSamples() { return m_color.data(); }
+  /// @brief 깊이 평면. 원소 형식은 depthFormat()에 따라 uint16_t (Unorm16) / uint32_t (Unorm24) / float
+  void* depthSamples() { return m_depth.data(); }
+  const void* depthSamples() const { return m_depth.data(); }
+
+  /// @brief 리졸브된 1x 색 (0xAARRGGBB, 행 우선, 한 행 outputPitch개). 반투명 합성과 후처리, 화면 출력이 쓴다
+  uint32_t* output() { return m_boundOutput != nullptr ? m_boundOutput : m_output.data(); }
+  int outputPitch() const { return m_boundOutput != nullptr ? m_boundPitch : m_width; }
+
+  /// @brief 다음 resolve부터 출력을 pixels(한 행 pitchInPixels개, width * height 이상)에 쓴다
+  /// 출력할 메모리에 바로 그려서 출력 평면 -> 출력 복사를 없앤다. nullptr이면 내부 출력 평면으로 돌아간다
+  void bindOutput(uint32_t* pixels, int pitchInPixels) {
+    m_boundOutput = pixels;
+    m_boundPitch = pitchInPixels;
+  }
+  bool isOutputBound() const { return m_boundOutput != nullptr; }
+
+private:
+  void fillTile(int tileX, int tileY);
+
+  int m_width = 0;
+  int m_height = 0;
+  int m_samples = 0;
+  Layout m_layout = Layout::Linear;
+  DepthFormat m_depthFormat = DepthFormat::Float32;
+  int m_tilesX = 0;
+  int m_tilesY = 0;
+
+  AlignedArray<uint32_t> m_color;
+  AlignedArray<uint8_t> m_depth;
+  AlignedArray<uint32_t> m_output;
+  uint32_t* m_boundOutput = nullptr;
+  int m_boundPitch = 0;
+
+  uint32_t m_clearColor = 0;
+  float m_clearDepth = 1.0f;
+  std::vector<uint8_t> m_pendingClear;
+  std::vector<float> m_hiZ;
+};
+
+const char* toString(FrameBuffer::Layout layout);
+
+}  // namespace ssr
@@ -0,0 +1,390 @@
+//------------------------------------------------------------------------------
+// File: FrameExporter.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "FrameExporter.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "ImageWriter.hpp"
+
+namespace ssr {
+
+namespace {
+
+bool equalsIgnoreCase(const std::string& a, const char* b) {
+  if (a.size() != std::strlen(b)) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 표준 출력을 바이너리 스트림으로 가져가고, 이후 printf / std::cout은 표준 에러로 가게 한다
+std::FILE* takeStdout() {
+  std::fflush(stdout);
+#ifdef _WIN32
+  const int fd = _dup(_fileno(stdout));
+  if (fd < 0) {
+    return nullptr;
+  }
+  _setmode(fd, _O_BINARY);
+  _dup2(_fileno(stderr), _fileno(stdout));
+  return _fdopen(fd, "wb");
+#else
+  const int fd = dup(STDOUT_FILENO);
+  if (fd < 0) {
+    return nullptr;
+  }
+  dup2(STDERR_FILENO, STDOUT_FILENO);
+  return fdopen(fd, "wb");
+#endif
+}
+
+// 파일 이름 패턴을 프레임 번호 앞 / 뒤로 나눈다. 허용하는 변환은 %d 또는 %0Nd 하나, 그리고 글자 그대로의 %%
+// 패턴을 printf에 그대로 넘기지 않으므로 다른 변환(%s, 번호 자리 둘 등)이나 짝 없는 %는 false
+bool splitIndexPattern(const std::string& pattern, std::string& prefix, std::string& suffix, int& digits,
+                       bool& found) {
+  prefix.clear();
+  suffix.clear();
+  digits = 0;
+  found = false;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    std::string& out = found ? suffix : prefix;
+    if (pattern[i] != '%') {
+      out += pattern[i];
+      continue;
+    }
+    if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+      out += '%';
+      ++i;
+      continue;
+    }
+    size_t j = i + 1;
+    int width = 0;
+    if (j < pattern.size() && pattern[j] == '0') {
+      for (++j; j < pattern.size() && std::isdigit((unsigned char)pattern[j]) != 0; ++j) {
+        width = width * 10 + (pattern[j] - '0');
+      }
+      if (width == 0 || width > 16) {
+        return false;
+      }
+    }
+    if (found || j >= pattern.size() || pattern[j] != 'd') {
+      return false;
+    }
+    found = true;
+    digits = width;
+    i = j;
+  }
+  return true;
+}
+
+inline uint8_t clampByte(int v) { return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v)); }
+
+// BT.601 full range (JPEG). 고정소수점 16비트
+inline int lumaOf(int r, int g, int b) { return (19595 * r + 38470 * g + 7471 * b + 32768) >> 16; }
+inline int cbOf(int r, int g, int b) { return ((-11059 * r - 21709 * g + 32768 * b + 32768) >> 16) + 128; }
+inline int crOf(int r, int g, int b) { return ((32768 * r - 27439 * g - 5329 * b + 32768) >> 16) + 128; }
+
+}  // namespace
+
+FrameExporter::~FrameExporter() { finish(); }
+
+bool FrameExporter::formatFromPath(const std::string& path, Format& out) {
+  const size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos) {
+    return false;
+  }
+  return parseFormat(path.c_str() + dot + 1, out);
+}
+
+bool FrameExporter::parseFormat(const char* name, Format& out) {
+  static const struct {
+    const char* name;
+    Format format;
+  } kNames[] = {
+    { "png", Format::Png }, { "ppm", Format::Ppm }, { "y4m", Format::Y4m },
+    { "raw", Format::Raw }, { "rgb", Format::Raw },
+  };
+  for (const auto& entry : kNames) {
+    if (equalsIgnoreCase(name, entry.name)) {
+      out = entry.format;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FrameExporter::start(const Settings& settings) {
+  finish();
+  m_settings = settings;
+  const bool stream = settings.format == Format::Y4m || settings.format == Format::Raw;
+  if (stream) {
+    m_stream = settings.path == "-" ? takeStdout() : std::fopen(settings.path.c_str(), "wb");
+    if (m_stream == nullptr) {
+      printf("export: cannot open %s\n", settings.path.c_str());
+      return false;
+    }
+    if (settings.format == Format::Y4m) {
+      std::fprintf(m_stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", settings.width, settings.height,
+                   settings.fps);
+    }
+  } else if (settings.path == "-") {
+    printf("export: %s sequences need a file name pattern\n", toString(settings.format));
+    return false;
+  } else {
+    bool found = false;
+    if (!splitIndexPattern(settings.path, m_pathPrefix, m_pathSuffix, m_indexDigits, found)) {
+      printf("export: bad file name pattern '%s' (one %%d or %%0Nd for the frame number, %%%% for a literal %%)\n",
+             settings.path.c_str());
+      return false;
+    }
+    if (!found && settings.numbered) {
+      // 번호 자리가 없으면 확장자 앞에 _0000 (디렉터리 이름의 점은 건너뜀)
+      const size_t slash = m_pathPrefix.find_last_of("/\\");
+      const size_t dot = m_pathPrefix.find_last_of('.');
+      const size_t split = dot != std::string::npos && (slash == std::string::npos || dot > slash) ? dot
+                                                                                                   : m_pathPrefix.size();
+      m_pathSuffix = m_pathPrefix.substr(split);
+      m_pathPrefix = m_pathPrefix.substr(0, split) + "_";
+      m_indexDigits = 4;
+    } else if (!found) {
+      m_indexDigits = -1;
+    }
+  }
+
+  const int depth = std::max(1, settings.queueDepth);
+  m_slots.assign(depth, Slot());
+  m_freeSlots.clear();
+  for (int i = depth - 1; i >= 0; --i) {
+    m_slots[i].pixels.resize((size_t)settings.width * settings.height);
+    m_freeSlots.push_back(i);
+  }
+  m_readySlots.clear();
+  m_stopping = false;
+  m_nextWrite = 0;
+  m_submitted = 0;
+  m_stalls = 0;
+  m_stallMs = 0.0;
+  m_writeErrors = 0;
+
+  const int threads = settings.threads > 0 ? settings.threads : 2;
+  for (int i = 0; i < threads; ++i) {
+    m_workers.emplace_back(&FrameExporter::workerLoop, this);
+  }
+  return true;
+}
+
+void FrameExporter::submit(const uint32_t* pixels, int pitchInPixels) {
+  if (!isRunning()) {
+    return;
+  }
+  int slotIndex = -1;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_freeSlots.empty()) {
+      // 인코더가 밀려 있으면 렌더 루프를 멈춘다 (메모리가 끝없이 늘지 않도록)
+      const auto stallStart = std::chrono::steady_clock::now();
+      m_slotFreed.wait(lock, [this] { return !m_freeSlots.empty(); });
+      ++m_stalls;
+      m_stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stallStart).count();
+    }
+    slotIndex = m_freeSlots.back();
+    m_freeSlots.pop_back();
+  }
+
+  // 복사는 잠금 밖에서 (슬롯은 이 스레드만 쥐고 있다)
+  Slot& slot = m_slots[slotIndex];
+  const int width = m_settings.width;
+  for (int y = 0; y < m_settings.height; ++y) {
+    std::memcpy(slot.pixels.data() + (size_t)y * width, pixels + (size_t)y * pitchInPixels, (size_t)width * 4);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    slot.index = m_submitted++;
+    m_readySlots.push_back(slotIndex);
+  }
+  m_frameReady.notify_one();
+}
+
+void FrameExporter::finish() {
+  if (!isRunning()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_frameReady.notify_all();
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+  m_workers.clear();
+  if (m_stream != nullptr) {
+    std::fclose(m_stream);
+    m_stream = nullptr;
+  }
+  std::fprintf(stderr, "export: %llu frames (%s), %llu stalls (%.1f ms blocked)%s\n",
+               (unsigned long long)m_submitted, toString(m_settings.format), (unsigned long long)m_stalls,
+               m_stallMs, m_writeErrors > 0 ? ", WRITE ERRORS" : "");
+}
+
+void FrameExporter::workerLoop() {
+  std::vector<uint8_t> encoded;
+  for (;;) {
+    int slotIndex = -1;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_frameReady.wait(lock, [this] { return m_stopping || !m_readySlots.empty(); });
+      if (m_readySlots.empty()) {
+        return;  // 멈추는 중이고 남은 프레임도 없음
+      }
+      slotIndex = m_readySlots.front();
+      m_readySlots.pop_front();
+    }
+
+    Slot& slot = m_slots[slotIndex];
+    const uint64_t index = slot.index;
+    encoded.clear();
+    encode(slot, encoded);
+    // 인코드한 뒤에는 슬롯이 필요 없으므로 쓰기 전에 돌려준다
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_freeSlots.push_back(slotIndex);
+    }
+    m_slotFreed.notify_one();
+
+    bool ok = true;
+    if (m_stream != nullptr) {
+      ok = writeOrdered(index, encoded);
+    } else {
+      const std::string path = sequencePath(index);
+      std::FILE* file = std::fopen(path.c_str(), "wb");
+      ok = file != nullptr && std::fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+      if (file != nullptr) {
+        ok = std::fclose(file) == 0 && ok;
+      }
+    }
+    if (!ok) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      ++m_writeErrors;
+    }
+  }
+}
+
+void FrameExporter::encode(const Slot& slot, std::vector<uint8_t>& out) const {
+  const int width = m_settings.width;
+  const int height = m_settings.height;
+  const uint32_t* pixels = slot.pixels.data();
+
+  switch (m_settings.format) {
+  case Format::Png:
+    image::encodePng(pixels, width, height, width, out);
+    break;
+  case Format::Ppm:
+    image::encodePpm(pixels, width, height, width, out);
+    break;
+  case Format::Raw: {
+    out.resize((size_t)width * height * 3);
+    uint8_t* dst = out.data();
+    for (size_t i = 0; i < (size_t)width * height; ++i) {
+      *dst++ = (uint8_t)(pixels[i] >> 16);
+      *dst++ = (uint8_t)(pixels[i] >> 8);
+      *dst++ = (uint8_t)pixels[i];
+    }
+    break;
+  }
+  case Format::Y4m: {
+    // FRAME 헤더 + Y (width x height) + Cb, Cr (각각 올림한 절반 크기, 2x2 평균)
+    static const char kFrameHeader[] = "FRAME\n";
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    const size_t lumaSize = (size_t)width * height;
+    const size_t chromaSize = (size_t)chromaWidth * chromaHeight;
+    out.resize(sizeof(kFrameHeader) - 1 + lumaSize + chromaSize * 2);
+    std::memcpy(out.data(), kFrameHeader, sizeof(kFrameHeader) - 1);
+    uint8_t* luma = out.data() + sizeof(kFrameHeader) - 1;
+    uint8_t* cb = luma + lumaSize;
+    uint8_t* cr = cb + chromaSize;
+    for (size_t i = 0; i < lumaSize; ++i) {
+      const uint32_t c = pixels[i];
+      luma[i] = clampByte(lumaOf((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF));
+    }
+    for (int cy = 0; cy < chromaHeight; ++cy) {
+      const int y0 = cy * 2;
+      const int y1 = std::min(y0 + 1, height - 1);
+      for (int cx = 0; cx < chromaWidth; ++cx) {
+        const int x0 = cx * 2;
+        const int x1 = std::min(x0 + 1, width - 1);
+        const uint32_t quad[4] = { pixels[(size_t)y0 * width + x0], pixels[(size_t)y0 * width + x1],
+                                   pixels[(size_t)y1 * width + x0], pixels[(size_t)y1 * width + x1] };
+        int r = 0;
+        int g = 0;
+        int b = 0;
+        for (uint32_t c : quad) {
+          r += (c >> 16) & 0xFF;
+          g += (c >> 8) & 0xFF;
+          b += c & 0xFF;
+        }
+        r = (r + 2) >> 2;
+        g = (g + 2) >> 2;
+        b = (b + 2) >> 2;
+        cb[(size_t)cy * chromaWidth + cx] = clampByte(cbOf(r, g, b));
+        cr[(size_t)cy * chromaWidth + cx] = clampByte(crOf(r, g, b));
+      }
+    }
+    break;
+  }
+  }
+}
+
+bool FrameExporter::writeOrdered(uint64_t index, const std::vector<uint8_t>& data) {
+  std::unique_lock<std::mutex> lock(m_writeMutex);
+  // 먼저 꺼낸 프레임이 먼저 인코드를 시작했으므로 앞 번호는 반드시 누군가 쥐고 있다 (교착 없음)
+  m_written.wait(lock, [this, index] { return m_nextWrite == index; });
+  const bool ok = std::fwrite(data.data(), 1, data.size(), m_stream) == data.size();
+  ++m_nextWrite;
+  lock.unlock();
+  m_written.notify_all();
+  return ok;
+}
+
+std::string FrameExporter::sequencePath(uint64_t index) const {
+  if (m_indexDigits < 0) {
+    return m_pathPrefix + m_pathSuffix;
+  }
+  char number[32];
+  std::snprintf(number, sizeof(number), "%0*llu", m_indexDigits, (unsigned long long)index);
+  return m_pathPrefix + number + m_pathSuffix;
+}
+
+const char* toString(FrameExporter::Format format) {
+  switch (format) {
+  case FrameExporter::Format::Png: return "PNG";
+  case FrameExporter::Format::Ppm: return "PPM";
+  case FrameExporter::Format::Y4m: return "Y4M";
+  case FrameExporter::Format::Raw: return "RGB24";
+  }
+  return "Unknown";
+}
+
+}  // namespace ssr
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+// File: FrameExporter.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ssr {
+
+/// @brief 완성된 프레임을 백그라운드 스레드에서 인코드해서 내보낸다
+/// 렌더 루프는 submit으로 프레임을 슬롯에 복사만 하고 바로 돌아간다. 슬롯 수(queueDepth)만큼만 프레임이 떠 있을 수 있고
+/// 모두 차 있으면 submit이 하나가 빌 때까지 기다린다 (배압). 인코더 스레드가 여러 개여도
+/// 스트림 형식(Y4M / Raw)은 프레임 순서대로 쓴다.
+class FrameExporter {
+public:
+  enum class Format {
+    /// 프레임마다 PNG 파일 (ssr::image, stored deflate)
+    Png,
+    /// 프레임마다 PPM(P6) 파일
+    Ppm,
+    /// YUV4MPEG2 스트림 하나. 4:2:0 (C420jpeg, BT.601 full range). 인코더에 바로 파이프로 넘길 수 있다
+    Y4m,
+    /// 헤더 없는 RGB24 스트림 (ffmpeg -f rawvideo -pix_fmt rgb24 -s WxH)
+    Raw,
+  };
+
+  struct Settings {
+    Format format = Format::Png;
+    /// Png / Ppm: 파일 이름 패턴. 프레임 번호 자리는 %d 또는 %0Nd 하나 (%%는 글자 %), 없으면 numbered일 때 확장자 앞에 _0000
+    /// Y4m / Raw: 파일 경로, "-"면 표준 출력 (이때 표준 출력에 찍던 로그는 표준 에러로 돌린다)
+    std::string path;
+    /// 패턴에 프레임 번호 자리가 없을 때 번호를 붙일지 (한 장만 쓸 때 false)
+    bool numbered = true;
+    int width = 0;
+    int height = 0;
+    /// Y4M 헤더의 프레임 속도
+    int fps = 60;
+    /// 동시에 떠 있을 수 있는 프레임 수 (복사한 슬롯)
+    int queueDepth = 4;
+    /// 인코더 스레드 수. 0이면 2
+    int threads = 0;
+  };
+
+  FrameExporter() = default;
+  ~FrameExporter();
+
+  FrameExporter(const FrameExporter&) = delete;
+  FrameExporter& operator=(const FrameExporter&) = delete;
+
+  /// @brief 스트림을 열고 인코더 스레드를 띄운다. 실패하면 false (이유는 출력)
+  bool start(const Settings& settings);
+
+  bool isRunning() const { return !m_workers.empty(); }
+
+  /// @brief start 때 정한 프레임 크기. submit하는 프레임은 이 크기여야 한다
+  int width() const { return m_settings.width; }
+  int height() const { return m_settings.height; }
+
+  /// @brief 프레임 한 장을 복사해 넣는다 (0xAARRGGBB, 한 행 pitchInPixels개, 크기는 Settings와 같아야 함)
+  void submit(const uint32_t* pixels, int pitchInPixels);
+
+  /// @brief 남은 프레임을 모두 쓰고 스레드를 멈춘 뒤 스트림을 닫는다. 통계를 한 줄 출력
+  void finish();
+
+  /// @brief 파일 이름 확장자로 형식 결정 (.png / .ppm / .y4m / .rgb, .raw). 모르면 false
+  static bool formatFromPath(const std::string& path, Format& out);
+  /// @brief "png", "ppm", "y4m", "raw"
+  static bool parseFormat(const char* name, Format& out);
+
+private:
+  struct Slot {
+    std::vector<uint32_t> pixels;
+    uint64_t index = 0;
+  };
+
+  void workerLoop();
+  void encode(const Slot& slot, std::vector<uint8_t>& out) const;
+  bool writeOrdered(uint64_t index, const std::vector<uint8_t>& data);
+  std::string sequencePath(uint64_t index) const;
+
+  Settings m_settings;
+  // 연속 파일 이름 = 앞 + 번호(m_indexDigits 자리, 0으로 채움. -1이면 번호 없음) + 뒤. start에서 패턴을 나눠 둔다
+  std::string m_pathPrefix;
+  std::string m_pathSuffix;
+  int m_indexDigits = -1;
+  std::FILE* m_stream = nullptr;
+  std::vector<std::thread> m_workers;
+  std::vector<Slot> m_slots;
+
+  // 빈 슬롯 / 인코드를 기다리는 슬롯 (제출 순서). 둘 다 m_mutex로 보호
+  std::mutex m_mutex;
+  std::condition_variable m_slotFreed;
+  std::condition_variable m_frameReady;
+  std::vector<int> m_freeSlots;
+  std::deque<int> m_readySlots;
+  bool m_stopping = false;
+
+  // 스트림 형식의 순서 맞추기
+  std::mutex m_writeMutex;
+  std::condition_variable m_written;
+  uint64_t m_nextWrite = 0;
+
+  // 통계 (m_mutex)
+  uint64_t m_submitted = 0;
+  uint64_t m_stalls = 0;
+  double m_stallMs = 0.0;
+  uint64_t m_writeErrors = 0;
+};
+
+const char* toString(FrameExporter::Format format);
+
+}  // namespace ssr
@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+// File: FramePacer.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "FramePacer.hpp"
+
+#include <SDL.h>
+
+#include <algorithm>
+
+namespace ssr {
+
+namespace {
+
+// spin margin의 하한 / 상한 (ms). 스케줄러 타임 슬라이스보다 짧게 자면 늦게 깨기 쉬우므로 하한을 둔다
+constexpr double kMinSpinMarginMs = 0.5;
+constexpr double kMaxSpinMarginMs = 4.0;
+
+}  // namespace
+
+void FramePacer::configure(Mode mode, double fps) {
+  m_mode = fps > 0.0 ? mode : Mode::Unlimited;
+  m_fps = m_mode == Mode::Unlimited ? 0.0 : fps;
+  m_frequency = SDL_GetPerformanceFrequency();
+  m_period = m_fps > 0.0 ? (uint64_t)((double)m_frequency / m_fps) : 0;
+  m_spinMargin = (uint64_t)(kMinSpinMarginMs * 0.001 * (double)m_frequency) * 2;
+  m_deadline = 0;
+  m_frames = 0;
+  m_missedFrames = 0;
+  m_worstLate = 0;
+  m_lastLate = 0;
+}
+
+bool FramePacer::wait() {
+  if (m_mode == Mode::Unlimited) {
+    return false;
+  }
+  ++m_frames;
+  uint64_t now = SDL_GetPerformanceCounter();
+  if (m_deadline == 0) {
+    // 첫 프레임은 기준만 잡는다
+    m_deadline = now + m_period;
+    return false;
+  }
+
+  bool missed = false;
+  m_lastLate = 0;
+  if (now > m_deadline) {
+    const uint64_t late = now - m_deadline;
+    m_lastLate = late;
+    m_worstLate = std::max(m_worstLate, late);
+    // VSync는 present가 이미 기다렸으므로 한 주기의 절반 넘게 늦은 것만 놓친 것으로 본다
+    missed = m_mode == Mode::Fixed || late > m_period / 2;
+    if (missed) {
+      ++m_missedFrames;
+    }
+  }
+  if (m_mode == Mode::VSync || now >= m_deadline) {
+    // VSync는 프레임 간격만 잰다. Fixed에서 늦었으면 밀린 마감을 쫓지 않고 지금부터 한 주기
+    m_deadline = now + m_period;
+    return missed;
+  }
+
+  // 1. 거칠게: spin margin을 남기고 ms 단위로 잔다
+  const uint64_t remaining = m_deadline - now;
+  if (remaining > m_spinMargin) {
+    const uint32_t sleepMs = (uint32_t)((remaining - m_spinMargin) * 1000 / m_frequency);
+    if (sleepMs > 0) {
+      const uint64_t sleepStart = now;
+      SDL_Delay(sleepMs);
+      now = SDL_GetPerformanceCounter();
+      // 요청보다 늦게 깬 만큼을 다음 margin에 반영 (늘릴 때는 바로, 줄일 때는 천천히)
+      const uint64_t requested = (uint64_t)sleepMs * m_frequency / 1000;
+      const uint64_t overshoot = now - sleepStart > requested ? now - sleepStart - requested : 0;
+      const uint64_t wanted = overshoot + overshoot / 4;
+      m_spinMargin = wanted > m_spinMargin ? wanted : m_spinMargin - (m_spinMargin - wanted) / 8;
+      const uint64_t minMargin = (uint64_t)(kMinSpinMarginMs * 0.001 * (double)m_frequency);
+      const uint64_t maxMargin = (uint64_t)(kMaxSpinMarginMs * 0.001 * (double)m_frequency);
+      m_spinMargin = std::clamp(m_spinMargin, minMargin, maxMargin);
+    }
+  }
+  // 2. 곱게: 마감까지 카운터를 돌며 기다린다
+  while (now < m_deadline) {
+    now = SDL_GetPerformanceCounter();
+  }
+  m_deadline += m_period;
+  return false;
+}
+
+double FramePacer::lastLateMs() const { return (double)m_lastLate * 1000.0 / (double)m_frequency; }
+
+double FramePacer::worstLateMs() const { return (double)m_worstLate * 1000.0 / (double)m_frequency; }
+
+double FramePacer::spinMarginMs() const { return (double)m_spinMargin * 1000.0 / (double)m_frequency; }
+
+const char* toString(FramePacer::Mode mode) {
+  switch (mode) {
+  case FramePacer::Mode::Unlimited: return "Unlimited";
+  case FramePacer::Mode::Fixed: return "Fixed";
+  case FramePacer::Mode::VSync: return "VSync";
+  }
+  return "Unknown";
+}
+
+}  // namespace ssr
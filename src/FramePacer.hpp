@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+// File: FramePacer.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+namespace ssr {
+
+/// @brief 목표 프레임 간격에 맞춰 메인 루프를 기다리게 하는 프레임 제한기
+/// 시간은 SDLProgram::updateTime과 같은 SDL_GetPerformanceCounter. 마감 시각까지 남은 시간 중
+/// 앞부분은 SDL_Delay로 자고(CPU를 쓰지 않음) 마지막 spin margin만큼은 카운터를 돌며 기다린다 (깨어나는 시각의 흔들림 제거).
+/// spin margin은 실제로 잠에서 늦게 깬 정도를 보고 늘리고 줄인다.
+/// 마감을 한 프레임 넘게 놓치면 밀린 마감을 따라잡으려 하지 않고 지금부터 다시 잰다 (놓친 수는 센다).
+class FramePacer {
+public:
+  enum class Mode {
+    /// 기다리지 않는다
+    Unlimited,
+    /// targetFps 간격으로 기다린다
+    Fixed,
+    /// present가 수직 동기에서 기다린다. 기다리지 않고 주사율 간격을 넘긴 프레임만 센다
+    VSync,
+  };
+
+  /// @brief fps는 Fixed면 목표, VSync면 화면 주사율 (놓친 프레임 판정용). 0 이하면 Unlimited
+  void configure(Mode mode, double fps);
+
+  Mode mode() const { return m_mode; }
+  double targetFps() const { return m_fps; }
+
+  /// @brief 프레임 끝에서 호출. 다음 마감까지 기다린다
+  /// @return 이번 프레임이 마감을 놓쳤으면 true
+  bool wait();
+
+  /// @brief configure 이후 wait한 프레임 수 / 마감을 놓친 프레임 수 / 가장 크게 늦은 시간 (ms)
+  uint64_t frames() const { return m_frames; }
+  uint64_t missedFrames() const { return m_missedFrames; }
+  double worstLateMs() const;
+  /// @brief 마지막 wait에서 마감보다 늦은 시간 (ms). 늦지 않았으면 0
+  double lastLateMs() const;
+
+  /// @brief 지금 쓰는 spin margin (ms)
+  double spinMarginMs() const;
+
+private:
+  Mode m_mode = Mode::Unlimited;
+  double m_fps = 0.0;
+  uint64_t m_frequency = 1;
+  uint64_t m_period = 0;
+  uint64_t m_deadline = 0;
+  uint64_t m_spinMargin = 0;
+  uint64_t m_frames = 0;
+  uint64_t m_missedFrames = 0;
+  uint64_t m_worstLate = 0;
+  uint64_t m_lastLate = 0;
+};
+
+const char* toString(FramePacer::Mode mode);
+
+}  // namespace ssr
@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+// File: Fxaa.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "Fxaa.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ThreadPool.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSR_FXAA_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ssr {
+
+namespace {
+
+// 에지 끝 탐색 거리 (픽셀). 짧은 에지는 앞쪽에서 끝나므로 대부분 2~3번 안에 멈춘다
+constexpr int kSearchSteps[] = { 1, 2, 3, 4, 6, 8, 12 };
+constexpr int kSearchStepCount = sizeof(kSearchSteps) / sizeof(kSearchSteps[0]);
+
+// Rec. 709 가중치를 256 합으로 맞춤. 감마 공간(sRGB) 값 그대로 쓴다 (FXAA 원본과 같음)
+inline uint32_t lumaOf(uint32_t c) {
+  return (((c >> 16) & 0xFF) * 54 + ((c >> 8) & 0xFF) * 183 + (c & 0xFF) * 19 + 128) >> 8;
+}
+
+inline uint32_t lerpColor(uint32_t a, uint32_t b, uint32_t t256) {
+  uint32_t out = a & 0xFF000000u;
+  for (int shift = 0; shift < 24; shift += 8) {
+    const int ca = (int)((a >> shift) & 0xFF);
+    const int cb = (int)((b >> shift) & 0xFF);
+    out |= (uint32_t)(ca + (((cb - ca) * (int)t256 + 128) >> 8)) << shift;
+  }
+  return out;
+}
+
+#if SSR_FXAA_SSE2
+// 4픽셀 휘도를 32비트 레인으로
+inline __m128i luma4(__m128i c) {
+  const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+  // (b, r) 16비트 쌍 * (19, 54), g * 183
+  const __m128i rbWeights = _mm_set1_epi32((54 << 16) | 19);
+  const __m128i gWeights = _mm_set1_epi32(183);
+  const __m128i rb = _mm_madd_epi16(_mm_and_si128(c, rbMask), rbWeights);
+  const __m128i g = _mm_madd_epi16(_mm_and_si128(_mm_srli_epi32(c, 8), _mm_set1_epi32(0xFF)), gWeights);
+  return _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(rb, g), _mm_set1_epi32(128)), 8);
+}
+#endif
+
+}  // namespace
+
+void Fxaa::computeLuma(const uint32_t* pixels, int pitchInPixels, int y0, int y1) {
+  for (int y = y0; y < y1; ++y) {
+    const uint32_t* src = pixels + (size_t)y * pitchInPixels;
+    uint8_t* dst = m_luma.data() + (size_t)y * m_width;
+    int x = 0;
+#if SSR_FXAA_SSE2
+    for (; x + 16 <= m_width; x += 16) {
+      const __m128i l0 = luma4(_mm_loadu_si128((const __m128i*)(src + x)));
+      const __m128i l1 = luma4(_mm_loadu_si128((const __m128i*)(src + x + 4)));
+      const __m128i l2 = luma4(_mm_loadu_si128((const __m128i*)(src + x + 8)));
+      const __m128i l3 = luma4(_mm_loadu_si128((const __m128i*)(src + x + 12)));
+      const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(l0, l1), _mm_packs_epi32(l2, l3));
+      _mm_storeu_si128((__m128i*)(dst + x), packed);
+    }
+#endif
+    for (; x < m_width; ++x) {
+      dst[x] = (uint8_t)lumaOf(src[x]);
+    }
+  }
+}
+
+void Fxaa::processBand(const uint32_t* pixels, int pitchInPixels, int band, int y0, int y1) {
+  std::vector<EdgeSample>& results = m_bandResults[band];
+  results.clear();
+
+  const int minThreshold = (int)(edgeThresholdMin * 255.0f + 0.5f);
+  // edgeThreshold를 2의 거듭제곱 역수로 근사해서 SIMD에서 시프트로 처리
+  const int thresholdShift = std::max(0, (int)std::lround(-std::log2(edgeThreshold)));
+
+  y0 = std::max(y0, 1);
+  y1 = std::min(y1, m_height - 1);
+  for (int y = y0; y < y1; ++y) {
+    const uint8_t* rowN = m_luma.data() + (size_t)(y - 1) * m_width;
+    const uint8_t* rowM = rowN + m_width;
+    const uint8_t* rowS = rowM + m_width;
+
+    int x = 1;
+#if SSR_FXAA_SSE2
+    // 16픽셀씩 상하좌우 + 중심의 최대 / 최소 휘도로 대비를 구하고 에지 픽셀만 골라냄
+    const __m128i minThresholdV = _mm_set1_epi8((char)minThreshold);
+    const __m128i shiftMask = _mm_set1_epi8((char)(0xFF >> thresholdShift));
+    const __m128i shiftCount = _mm_cvtsi32_si128(thresholdShift);
+    for (; x + 16 <= m_width - 1; x += 16) {
+      const __m128i m = _mm_loadu_si128((const __m128i*)(rowM + x));
+      const __m128i n = _mm_loadu_si128((const __m128i*)(rowN + x));
+      const __m128i s = _mm_loadu_si128((const __m128i*)(rowS + x));
+      const __m128i w = _mm_loadu_si128((const __m128i*)(rowM + x - 1));
+      const __m128i e = _mm_loadu_si128((const __m128i*)(rowM + x + 1));
+      const __m128i maxV = _mm_max_epu8(_mm_max_epu8(_mm_max_epu8(n, s), _mm_max_epu8(w, e)), m);
+      const __m128i minV = _mm_min_epu8(_mm_min_epu8(_mm_min_epu8(n, s), _mm_min_epu8(w, e)), m);
+      const __m128i range = _mm_subs_epu8(maxV, minV);
+      // 바이트 단위 시프트가 없으므로 16비트로 밀고 넘어온 비트를 지움
+      const __m128i relative = _mm_and_si128(_mm_srl_epi16(maxV, shiftCount), shiftMask);
+      const __m128i threshold = _mm_max_epu8(relative, minThresholdV);
+      // range >= threshold  <=>  threshold - range (포화) == 0
+      const __m128i below = _mm_subs_epu8(threshold, range);
+      int edges = _mm_movemask_epi8(_mm_cmpeq_epi8(below, _mm_setzero_si128()));
+      while (edges != 0) {
+        int bit = 0;
+        while ((edges & (1 << bit)) == 0) {
+          ++bit;
+        }
+        edges &= edges - 1;
+        const uint32_t index = (uint32_t)((size_t)y * pitchInPixels + x + bit);
+        results.push_back({ index, blendEdgePixel(pixels, pitchInPixels, x + bit, y) });
+      }
+    }
+#endif
+    for (; x < m_width - 1; ++x) {
+      const int m = rowM[x], n = rowN[x], s = rowS[x], w = rowM[x - 1], e = rowM[x + 1];
+      const int maxL = std::max(std::max(std::max(n, s), std::max(w, e)), m);
+      const int minL = std::min(std::min(std::min(n, s), std::min(w, e)), m);
+      const int threshold = std::max(maxL >> thresholdShift, minThreshold);
+      if (maxL - minL < threshold) {
+        continue;
+      }
+      const uint32_t index = (uint32_t)((size_t)y * pitchInPixels + x);
+      results.push_back({ index, blendEdgePixel(pixels, pitchInPixels, x, y) });
+    }
+  }
+}
+
+uint32_t Fxaa::blendEdgePixel(const uint32_t* pixels, int pitchInPixels, int x, int y) const {
+  // 휘도는 0~255 정수 그대로 다룬다. 부동소수는 서브픽셀 곡선과 최종 블렌딩 비율에만 사용
+  const uint8_t* rowN = m_luma.data() + (size_t)(y - 1) * m_width;
+  const uint8_t* rowM = rowN + m_width;
+  const uint8_t* rowS = rowM + m_width;
+  const int lumaM = rowM[x];
+  const int lumaN = rowN[x], lumaS = rowS[x];
+  const int lumaW = rowM[x - 1], lumaE = rowM[x + 1];
+  const int lumaNW = rowN[x - 1], lumaNE = rowN[x + 1];
+  const int lumaSW = rowS[x - 1], lumaSE = rowS[x + 1];
+  const int range = std::max(std::max(std::max(lumaN, lumaS), std::max(lumaW, lumaE)), lumaM) -
+                    std::min(std::min(std::min(lumaN, lumaS), std::min(lumaW, lumaE)), lumaM);
+
+  // 서브픽셀: 3x3 저역 통과 평균과 중심의 차이가 클수록 (한 픽셀짜리 점, 선) 많이 섞음
+  const int average12 = 2 * (lumaN + lumaS + lumaW + lumaE) + (lumaNW + lumaNE + lumaSW + lumaSE);
+  float subpixel = std::min((float)std::abs(average12 - 12 * lumaM) / (float)(12 * range), 1.0f);
+  subpixel = (-2.0f * subpixel + 3.0f) * subpixel * subpixel;
+  subpixel = subpixel * subpixel * subpixelQuality;
+
+  // 에지 방향: 세로 방향 2차 차분이 크면 수평 에지 (위아래 행과 섞음)
+  const int horizontal = std::abs(lumaNW - 2 * lumaW + lumaSW) +
+                         2 * std::abs(lumaN - 2 * lumaM + lumaS) +
+                         std::abs(lumaNE - 2 * lumaE + lumaSE);
+  const int vertical = std::abs(lumaNW - 2 * lumaN + lumaNE) +
+                       2 * std::abs(lumaW - 2 * lumaM + lumaE) +
+                       std::abs(lumaSW - 2 * lumaS + lumaSE);
+  const bool isHorizontal = horizontal >= vertical;
+
+  // 에지 건너편: 기울기가 더 가파른 쪽
+  const int luma1 = isHorizontal ? lumaN : lumaW;
+  const int luma2 = isHorizontal ? lumaS : lumaE;
+  const int gradient1 = std::abs(luma1 - lumaM);
+  const int gradient2 = std::abs(luma2 - lumaM);
+  const bool towardFirst = gradient1 >= gradient2;
+  // 에지 평균과 탐색 값은 두 픽셀 합(휘도 2배 단위), 끝 판정 기준은 기울기의 1/4
+  const int localSum = (towardFirst ? luma1 : luma2) + lumaM;
+  const int endThreshold = std::max(gradient1, gradient2);
+
+  // 에지를 따라 양쪽으로 가면서 (현재 행 + 건너편 행)이 에지 평균에서 벗어나는 곳을 찾음
+  const int across = towardFirst ? -1 : 1;
+  const int oppositeOffset = isHorizontal ? across * m_width : across;
+  const int alongStep = isHorizontal ? 1 : m_width;
+  const int limitNeg = isHorizontal ? x : y;
+  const int limitPos = isHorizontal ? m_width - 1 - x : m_height - 1 - y;
+  const uint8_t* center = rowM + x;
+
+  auto searchEnd = [&](int sign, int limit, int& lumaEnd) {
+    for (int i = 0; i < kSearchStepCount; ++i) {
+      const int step = std::min(kSearchSteps[i], limit);
+      const uint8_t* p = center + sign * step * alongStep;
+      lumaEnd = p[0] + p[oppositeOffset] - localSum;
+      // |lumaEnd / 2| >= gradient / 4
+      if (2 * std::abs(lumaEnd) >= endThreshold || step == limit) {
+        return step;
+      }
+    }
+    return kSearchSteps[kSearchStepCount - 1];
+  };
+  int lumaEndNeg = 0, lumaEndPos = 0;
+  const int distanceNeg = searchEnd(-1, limitNeg, lumaEndNeg);
+  const int distancePos = searchEnd(1, limitPos, lumaEndPos);
+
+  // 가까운 끝에서의 휘도 변화가 중심과 같은 방향이면 이 픽셀은 에지 끝쪽이라 많이 섞음
+  const bool centerSmaller = 2 * lumaM < localSum;
+  const int lumaEndNear = distanceNeg < distancePos ? lumaEndNeg : lumaEndPos;
+  float edgeBlend = 0.0f;
+  if ((lumaEndNear < 0) != centerSmaller) {
+    edgeBlend = 0.5f - (float)std::min(distanceNeg, distancePos) / (float)(distanceNeg + distancePos);
+  }
+
+  const float blend = std::max(edgeBlend, subpixel);
+  const uint32_t* colorM = pixels + (size_t)y * pitchInPixels + x;
+  const uint32_t colorOpposite = isHorizontal ? colorM[across * pitchInPixels] : colorM[across];
+  return lerpColor(*colorM, colorOpposite, (uint32_t)(blend * 256.0f + 0.5f));
+}
+
+void Fxaa::apply(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool) {
+  if (width < 3 || height < 3) {
+    return;
+  }
+  if (m_width != width || m_height != height) {
+    m_width = width;
+    m_height = height;
+    m_luma.resize((size_t)width * height);
+  }
+  const int bandCount = (height + ThreadPool::kRowBand - 1) / ThreadPool::kRowBand;
+  if ((int)m_bandResults.size() < bandCount) {
+    m_bandResults.resize(bandCount);
+  }
+
+  // 1. 휘도
+  pool.parallelFor(height, ThreadPool::kRowBand, [&](int y0, int y1) {
+    computeLuma(pixels, pitchInPixels, y0, y1);
+  });
+
+  // 2. 에지 판정과 블렌딩 결과 계산 (원본만 읽음)
+  pool.parallelFor(bandCount, 1, [&](int b0, int b1) {
+    for (int band = b0; band < b1; ++band) {
+      processBand(pixels, pitchInPixels, band, band * ThreadPool::kRowBand, std::min(height, (band + 1) * ThreadPool::kRowBand));
+    }
+  });
+
+  // 3. 반영. band마다 자기 행에만 쓴다
+  pool.parallelFor(bandCount, 1, [&](int b0, int b1) {
+    for (int band = b0; band < b1; ++band) {
+      for (const EdgeSample& sample : m_bandResults[band]) {
+        pixels[sample.index] = sample.color;
+      }
+    }
+  });
+}
+
+}  // namespace ssr
@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------
+// File: Fxaa.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ssr {
+
+class ThreadPool;
+
+/// @brief FXAA 계열 후처리 안티에일리어싱 (Lottes, FXAA 3.11 Quality를 CPU용으로 줄인 것)
+/// 샘플 버퍼 없이 최종 프레임버퍼만 보고 휘도 대비가 큰 픽셀을 골라 에지 방향으로 이웃과 섞는다.
+/// 1. 휘도 평면 계산 (SIMD)  2. 16픽셀씩 지역 대비로 에지 판정 (SIMD), 에지 픽셀만 탐색 / 블렌딩
+/// 3. 결과 반영. 각 단계는 행 묶음(band) 단위로 나눠 ThreadPool에서 병렬로 돈다.
+/// 2단계는 원본만 읽고 결과를 band별 목록에 모으므로 band 경계에서도 이미 바뀐 픽셀을 읽지 않는다.
+class Fxaa {
+public:
+  /// @brief pixels(0xAARRGGBB, 한 행 pitchInPixels개)를 제자리에서 안티에일리어싱
+  /// 화면 가장자리 1픽셀은 건드리지 않는다
+  void apply(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool);
+
+  /// @brief 에지로 볼 최소 지역 대비. 지역 최대 휘도에 대한 비율과 절대값 중 큰 쪽
+  float edgeThreshold = 1.0f / 8.0f;
+  float edgeThresholdMin = 1.0f / 12.0f;
+  /// @brief 서브픽셀 에일리어싱 제거 강도 [0, 1]
+  float subpixelQuality = 0.75f;
+
+private:
+  struct EdgeSample {
+    uint32_t index;
+    uint32_t color;
+  };
+
+  void computeLuma(const uint32_t* pixels, int pitchInPixels, int y0, int y1);
+  void processBand(const uint32_t* pixels, int pitchInPixels, int band, int y0, int y1);
+  uint32_t blendEdgePixel(const uint32_t* pixels, int pitchInPixels, int x, int y) const;
+
+  int m_width = 0;
+  int m_height = 0;
+  std::vector<uint8_t> m_luma;
+  std::vector<std::vector<EdgeSample>> m_bandResults;
+};
+
+}  // namespace ssr
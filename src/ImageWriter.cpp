@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+// File: ImageWriter.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "ImageWriter.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace ssr {
+
+namespace image {
+
+namespace {
+
+// 압축하지 않은(stored) deflate 블록 하나의 최대 길이
+constexpr size_t kStoredBlockMax = 65535;
+
+const uint32_t* crcTable() {
+  static uint32_t table[256];
+  static const bool initialized = [] {
+    for (uint32_t n = 0; n < 256; ++n) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) != 0 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      table[n] = c;
+    }
+    return true;
+  }();
+  (void)initialized;
+  return table;
+}
+
+uint32_t updateCrc(uint32_t crc, const uint8_t* data, size_t size) {
+  const uint32_t* table = crcTable();
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back((uint8_t)(value >> 24));
+  out.push_back((uint8_t)(value >> 16));
+  out.push_back((uint8_t)(value >> 8));
+  out.push_back((uint8_t)value);
+}
+
+// 길이 / 형식 / 내용 / CRC(형식 + 내용)
+void appendChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size) {
+  appendBigEndian(out, (uint32_t)size);
+  const size_t typeOffset = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data, data + size);
+  const uint32_t crc = updateCrc(0xFFFFFFFFu, out.data() + typeOffset, size + 4) ^ 0xFFFFFFFFu;
+  appendBigEndian(out, crc);
+}
+
+}  // namespace
+
+void encodePpm(const uint32_t* pixels, int width, int height, int pitchInPixels, std::vector<uint8_t>& out) {
+  char header[64];
+  const int headerSize = std::snprintf(header, sizeof(header), "P6\n%d %d\n255\n", width, height);
+  const size_t begin = out.size();
+  out.resize(begin + headerSize + (size_t)width * height * 3);
+  std::memcpy(out.data() + begin, header, headerSize);
+  uint8_t* dst = out.data() + begin + headerSize;
+  for (int y = 0; y < height; ++y) {
+    const uint32_t* row = pixels + (size_t)y * pitchInPixels;
+    for (int x = 0; x < width; ++x) {
+      const uint32_t c = row[x];
+      *dst++ = (uint8_t)(c >> 16);
+      *dst++ = (uint8_t)(c >> 8);
+      *dst++ = (uint8_t)c;
+    }
+  }
+}
+
+void encodePng(const uint32_t* pixels, int width, int height, int pitchInPixels, std::vector<uint8_t>& out) {
+  static const uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+  out.insert(out.end(), kSignature, kSignature + 8);
+
+  // IHDR: 8비트 RGB, 비월 없음
+  std::vector<uint8_t> header;
+  appendBigEndian(header, (uint32_t)width);
+  appendBigEndian(header, (uint32_t)height);
+  header.insert(header.end(), { 8, 2, 0, 0, 0 });
+  appendChunk(out, "IHDR", header.data(), header.size());
+
+  // 필터 없는 스캔라인 (행마다 필터 바이트 0 + RGB)
+  const size_t rowBytes = 1 + (size_t)width * 3;
+  std::vector<uint8_t> raw(rowBytes * height);
+  for (int y = 0; y < height; ++y) {
+    const uint32_t* row = pixels + (size_t)y * pitchInPixels;
+    uint8_t* dst = raw.data() + rowBytes * y;
+    *dst++ = 0;
+    for (int x = 0; x < width; ++x) {
+      const uint32_t c = row[x];
+      *dst++ = (uint8_t)(c >> 16);
+      *dst++ = (uint8_t)(c >> 8);
+      *dst++ = (uint8_t)c;
+    }
+  }
+
+  // zlib 스트림: 헤더 + stored 블록들 + Adler-32. 압축하지 않으므로 인코드 비용은 복사와 체크섬뿐
+  std::vector<uint8_t> zlib;
+  const size_t blockCount = std::max<size_t>(1, (raw.size() + kStoredBlockMax - 1) / kStoredBlockMax);
+  zlib.reserve(2 + raw.size() + blockCount * 5 + 4);
+  zlib.push_back(0x78);
+  zlib.push_back(0x01);
+  size_t offset = 0;
+  do {
+    const size_t size = std::min(kStoredBlockMax, raw.size() - offset);
+    const bool last = offset + size == raw.size();
+    zlib.push_back(last ? 1 : 0);
+    zlib.push_back((uint8_t)size);
+    zlib.push_back((uint8_t)(size >> 8));
+    zlib.push_back((uint8_t)~size);
+    zlib.push_back((uint8_t)(~size >> 8));
+    zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+    offset += size;
+  } while (offset < raw.size());
+
+  // Adler-32. 5552바이트마다 나머지를 구하면 32비트에서 넘치지 않는다
+  uint32_t a = 1;
+  uint32_t b = 0;
+  for (size_t i = 0; i < raw.size();) {
+    const size_t end = std::min(raw.size(), i + 5552);
+    for (; i < end; ++i) {
+      a += raw[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+  appendBigEndian(zlib, (b << 16) | a);
+
+  appendChunk(out, "IDAT", zlib.data(), zlib.size());
+  appendChunk(out, "IEND", nullptr, 0);
+}
+
+}  // namespace image
+
+}  // namespace ssr
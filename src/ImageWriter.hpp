@@ -0,0 +1,26 @@
+//------------------------------------------------------------------------------
+// File: ImageWriter.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ssr {
+
+/// @brief 렌더 결과의 이미지 파일 인코더. 외부 라이브러리 없이 PPM(P6)과 PNG(압축하지 않은 deflate 블록)만
+/// 입력은 모두 출력 평면과 같은 0xAARRGGBB, 행 우선, 한 행 pitchInPixels개. 알파는 버린다 (RGB 8비트)
+/// 형식 선택과 파일 쓰기는 FrameExporter
+namespace image {
+
+/// @brief out 끝에 이미지 파일 내용을 덧붙인다
+void encodePpm(const uint32_t* pixels, int width, int height, int pitchInPixels, std::vector<uint8_t>& out);
+void encodePng(const uint32_t* pixels, int width, int height, int pitchInPixels, std::vector<uint8_t>& out);
+
+}  // namespace image
+
+}  // namespace ssr
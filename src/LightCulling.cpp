@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+// File: LightCulling.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "LightCulling.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ssr {
+
+void TiledLightGrid::build(const std::vector<PointLight>& lights,
+                           const Matrix4x4& cameraMat, const Matrix4x4& projectionMat,
+                           const Matrix4x4& viewportMat, int width, int height, float zNear) {
+  m_tilesX = (width + kTileSize - 1) / kTileSize;
+  m_tilesY = (height + kTileSize - 1) / kTileSize;
+  const int tileCount = m_tilesX * m_tilesY;
+
+  // 1. 광원마다 화면 타일 범위 계산
+  m_lightRects.resize(lights.size());
+  for (size_t i = 0; i < lights.size(); ++i) {
+    const PointLight& light = lights[i];
+    TileRect& rect = m_lightRects[i];
+    rect = { 0, 0, -1, -1 };
+
+    Vector4 center = { light.position.x, light.position.y, light.position.z, 1.0f };
+    center = cameraMat * center;
+    const float r = light.range;
+
+    // 구 전체가 near 평면 뒤에 있으면 보이지 않음
+    if (center.z + r < zNear) {
+      continue;
+    }
+
+    // near 평면에 걸치면 투영이 뒤집히므로 화면 전체로 처리
+    if (center.z - r < zNear) {
+      rect = { 0, 0, m_tilesX - 1, m_tilesY - 1 };
+      continue;
+    }
+
+    // 카메라 공간에서 구를 감싸는 AABB의 8개 꼭짓점을 투영해서 화면 사각형을 구함
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    for (int corner = 0; corner < 8; ++corner) {
+      Vector4 p = { center.x + ((corner & 1) ? r : -r),
+                    center.y + ((corner & 2) ? r : -r),
+                    center.z + ((corner & 4) ? r : -r), 1.0f };
+      p = projectionMat * p;
+      p.perspectiveDivide();
+      p = viewportMat * p;
+      minX = std::min(minX, p.x);
+      maxX = std::max(maxX, p.x);
+      minY = std::min(minY, p.y);
+      maxY = std::max(maxY, p.y);
+    }
+
+    if (maxX < 0.0f || maxY < 0.0f || minX >= (float)width || minY >= (float)height) {
+      continue;
+    }
+
+    rect.x0 = std::max(0, (int)std::floor(minX) / kTileSize);
+    rect.y0 = std::max(0, (int)std::floor(minY) / kTileSize);
+    rect.x1 = std::min(m_tilesX - 1, (int)std::ceil(maxX) / kTileSize);
+    rect.y1 = std::min(m_tilesY - 1, (int)std::ceil(maxY) / kTileSize);
+  }
+
+  // 2. 타일마다 광원 개수를 세고 누적합으로 오프셋 계산
+  m_offsets.assign(tileCount + 1, 0);
+  for (const TileRect& rect : m_lightRects) {
+    for (int ty = rect.y0; ty <= rect.y1; ++ty) {
+      for (int tx = rect.x0; tx <= rect.x1; ++tx) {
+        ++m_offsets[tx + ty * m_tilesX + 1];
+      }
+    }
+  }
+  for (int t = 0; t < tileCount; ++t) {
+    m_offsets[t + 1] += m_offsets[t];
+  }
+
+  // 3. 인덱스 채우기. 광원 순서대로 넣으므로 타일 목록도 인덱스 오름차순
+  m_indices.resize(m_offsets[tileCount]);
+  m_cursor.assign(m_offsets.begin(), m_offsets.end() - 1);
+  for (size_t i = 0; i < m_lightRects.size(); ++i) {
+    const TileRect& rect = m_lightRects[i];
+    for (int ty = rect.y0; ty <= rect.y1; ++ty) {
+      for (int tx = rect.x0; tx <= rect.x1; ++tx) {
+        m_indices[m_cursor[tx + ty * m_tilesX]++] = (uint32_t)i;
+      }
+    }
+  }
+}
+
+}  // namespace ssr
@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+// File: LightCulling.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Lighting.hpp"
+#include "Math.hpp"
+
+namespace ssr {
+
+/// @brief 화면을 kTileSize 크기 타일로 나누고 타일마다 영향을 주는 점광원 목록을 만든다.
+/// 매 프레임 build()로 다시 만들고, 픽셀 셰이딩은 자기 타일의 목록만 순회한다.
+/// 방향광은 화면 전체에 영향을 주므로 여기서 다루지 않는다.
+class TiledLightGrid {
+public:
+  static constexpr int kTileSize = 16;
+
+  /// @brief 점광원의 경계 구를 카메라 / 프로젝션 / 뷰포트 행렬로 투영해서 타일 목록 구성
+  /// 구가 near 평면에 걸치면 보수적으로 화면 전체 타일에 등록한다.
+  void build(const std::vector<PointLight>& lights,
+             const Matrix4x4& cameraMat, const Matrix4x4& projectionMat,
+             const Matrix4x4& viewportMat, int width, int height, float zNear);
+
+  int tileIndex(int x, int y) const {
+    return (x / kTileSize) + (y / kTileSize) * m_tilesX;
+  }
+
+  /// @brief 타일에 등록된 점광원 인덱스 (LightSet::points 기준)
+  const uint32_t* tileLights(int tile) const { return m_indices.data() + m_offsets[tile]; }
+
+  uint32_t tileLightCount(int tile) const { return m_offsets[tile + 1] - m_offsets[tile]; }
+
+  int tilesX() const { return m_tilesX; }
+
+  int tilesY() const { return m_tilesY; }
+
+  /// @brief 모든 타일 목록 길이의 합 (디버그 통계용)
+  size_t totalEntries() const { return m_indices.size(); }
+
+private:
+  struct TileRect {
+    int x0, y0, x1, y1;  // 포함 범위, x0 > x1 이면 화면 밖
+  };
+
+  int m_tilesX = 0;
+  int m_tilesY = 0;
+
+  std::vector<TileRect> m_lightRects;
+  // CSR 형태: 타일 t의 목록은 m_indices[m_offsets[t] .. m_offsets[t + 1])
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint32_t> m_indices;
+  std::vector<uint32_t> m_cursor;
+};
+
+}  // namespace ssr
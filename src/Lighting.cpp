@@ -0,0 +1,420 @@
+//------------------------------------------------------------------------------
+// File: Lighting.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "Lighting.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ColorSpace.hpp"
+#include "FastMath.hpp"
+#include "SIMD.hpp"
+#include "ShadowMap.hpp"
+
+namespace ssr {
+
+const char* toString(ReflectionModel model) {
+  switch (model) {
+  case ReflectionModel::Lambert: return "Lambert";
+  case ReflectionModel::HalfLambert: return "HalfLambert";
+  case ReflectionModel::Phong: return "Phong";
+  case ReflectionModel::BlinnPhong: return "BlinnPhong";
+  }
+  return "Unknown";
+}
+
+const char* toString(ShadingFrequency frequency) {
+  switch (frequency) {
+  case ShadingFrequency::Flat: return "Flat";
+  case ShadingFrequency::Vertex: return "Vertex";
+  case ShadingFrequency::Pixel: return "Pixel";
+  }
+  return "Unknown";
+}
+
+const char* toString(SurfaceType surface) {
+  switch (surface) {
+  case SurfaceType::Textured: return "Textured";
+  case SurfaceType::Water: return "Water";
+  case SurfaceType::Fire: return "Fire";
+  }
+  return "Unknown";
+}
+
+namespace lighting {
+
+namespace {
+
+// SoA로 나뉜 3차원 벡터 4개
+struct Vec3x4 {
+  Float4 x, y, z;
+};
+
+struct LightAccum {
+  Float4 diffuseR, diffuseG, diffuseB;
+  Float4 specularR, specularG, specularB;
+};
+
+// 배치 호출마다 한 번만 계산해 두는 방향광 정보
+struct PreparedDirectional {
+  float toLightX, toLightY, toLightZ;
+  float r, g, b;
+  const ShadowMap* shadowMap;
+};
+
+inline Float4 dot3(const Vec3x4& a, const Vec3x4& b) {
+  return ssr::dot3(a.x, a.y, a.z, b.x, b.y, b.z);
+}
+
+inline Vec3x4 normalize(const Vec3x4& v) {
+  Float4 lenSq = max(dot3(v, v), Float4::splat(1e-12f));
+  Float4 invLen = fastmath::rsqrt(lenSq);
+  return { v.x * invLen, v.y * invLen, v.z * invLen };
+}
+
+// 광원 하나의 기여를 누적
+// toLight: 정규화된 표면 -> 광원 벡터, radiance: 색 * 세기 * 감쇠
+inline void accumulateLight(const Material& material, const Vec3x4& n, const Vec3x4& v,
+                            const Vec3x4& toLight, Float4 radianceR, Float4 radianceG,
+                            Float4 radianceB, LightAccum& acc) {
+  const Float4 zero = Float4::splat(0.0f);
+  const Float4 half = Float4::splat(0.5f);
+  const Float4 nDotL = dot3(n, toLight);
+
+  Float4 diffuse;
+  if (material.model == ReflectionModel::HalfLambert) {
+    Float4 wrapped = nDotL * half + half;
+    diffuse = wrapped * wrapped;
+  } else {
+    diffuse = max(nDotL, zero);
+  }
+  acc.diffuseR = acc.diffuseR + radianceR * diffuse;
+  acc.diffuseG = acc.diffuseG + radianceG * diffuse;
+  acc.diffuseB = acc.diffuseB + radianceB * diffuse;
+
+  // 빛을 등진 면에는 정반사가 생기지 않는다. 4개 모두 등졌으면 pow까지 가지 않음
+  const Float4 facing = greaterThan(nDotL, zero);
+  if ((material.model != ReflectionModel::Phong && material.model != ReflectionModel::BlinnPhong) ||
+      !any(facing)) {
+    return;
+  }
+
+  Float4 base;
+  if (material.model == ReflectionModel::Phong) {
+    // R = 2(N·L)N - L
+    Float4 twoNDotL = nDotL + nDotL;
+    Vec3x4 r = { n.x * twoNDotL - toLight.x, n.y * twoNDotL - toLight.y, n.z * twoNDotL - toLight.z };
+    base = max(dot3(r, v), zero);
+  } else {
+    // H = normalize(L + V)
+    Vec3x4 h = normalize({ toLight.x + v.x, toLight.y + v.y, toLight.z + v.z });
+    base = max(dot3(n, h), zero);
+  }
+
+  Float4 specular = select(facing, fastmath::pow(base, material.shininess), zero);
+  acc.specularR = acc.specularR + radianceR * specular;
+  acc.specularG = acc.specularG + radianceG * specular;
+  acc.specularB = acc.specularB + radianceB * specular;
+}
+
+void prepareDirectionals(const LightSet& lights, std::vector<PreparedDirectional>& out) {
+  out.clear();
+  for (const DirectionalLight& light : lights.directionals) {
+    Vector3 toLight = (light.direction * -1.0f).normalize();
+    out.push_back({ toLight.x, toLight.y, toLight.z,
+                    light.color.x * light.intensity,
+                    light.color.y * light.intensity,
+                    light.color.z * light.intensity,
+                    light.shadowMap });
+  }
+}
+
+// 평가할 점광원 목록. indices가 nullptr이면 전체
+struct PointLightList {
+  const PointLight* lights;
+  const uint32_t* indices;
+  uint32_t count;
+
+  const PointLight& operator[](uint32_t i) const {
+    return indices != nullptr ? lights[indices[i]] : lights[i];
+  }
+};
+
+// 4개의 표면 지점에 대해 광원을 평가
+// 결과는 재질 색이 곱해진 확산광(앰비언트 포함)과 정반사광
+void evaluateLights(const LightSet& lights, const std::vector<PreparedDirectional>& directionals,
+                    const PointLightList& points, const Material& material, const Vector3& eye,
+                    const Vec3x4& position, const Vec3x4& normal, LightAccum& acc) {
+  const Float4 zero = Float4::splat(0.0f);
+  const Float4 one = Float4::splat(1.0f);
+
+  Vec3x4 n = normalize(normal);
+  Vec3x4 v = normalize({ Float4::splat(eye.x) - position.x,
+                         Float4::splat(eye.y) - position.y,
+                         Float4::splat(eye.z) - position.z });
+
+  acc.diffuseR = Float4::splat(lights.ambient.x);
+  acc.diffuseG = Float4::splat(lights.ambient.y);
+  acc.diffuseB = Float4::splat(lights.ambient.z);
+  acc.specularR = zero;
+  acc.specularG = zero;
+  acc.specularB = zero;
+
+  for (const PreparedDirectional& light : directionals) {
+    Vec3x4 toLight = { Float4::splat(light.toLightX), Float4::splat(light.toLightY),
+                       Float4::splat(light.toLightZ) };
+    Float4 radianceR = Float4::splat(light.r);
+    Float4 radianceG = Float4::splat(light.g);
+    Float4 radianceB = Float4::splat(light.b);
+
+    if (light.shadowMap != nullptr) {
+      // 노멀 방향으로 조금 밀어낸 지점에서 샘플링해서 자기 그림자 여드름을 줄인다
+      Float4 offset = Float4::splat(light.shadowMap->normalOffset());
+      float sx[4], sy[4], sz[4], visibility[4];
+      (position.x + n.x * offset).store(sx);
+      (position.y + n.y * offset).store(sy);
+      (position.z + n.z * offset).store(sz);
+      light.shadowMap->visibility4(sx, sy, sz, visibility);
+      Float4 vis = Float4::load(visibility);
+      radianceR = radianceR * vis;
+      radianceG = radianceG * vis;
+      radianceB = radianceB * vis;
+    }
+
+    accumulateLight(material, n, v, toLight, radianceR, radianceG, radianceB, acc);
+  }
+
+  for (uint32_t p = 0; p < points.count; ++p) {
+    const PointLight& light = points[p];
+    Vec3x4 toLight = { Float4::splat(light.position.x) - position.x,
+                       Float4::splat(light.position.y) - position.y,
+                       Float4::splat(light.position.z) - position.z };
+    Float4 distSq = dot3(toLight, toLight);
+    const float rangeSqScalar = light.range * light.range;
+    Float4 rangeSq = Float4::splat(rangeSqScalar);
+
+    // 4개 지점 모두 범위 밖이면 건너뜀
+    Float4 inRange = greaterThan(rangeSq, distSq);
+    if (!any(inRange)) {
+      continue;
+    }
+
+    Float4 invDist = fastmath::rsqrt(max(distSq, Float4::splat(1e-12f)));
+    toLight = { toLight.x * invDist, toLight.y * invDist, toLight.z * invDist };
+
+    // (1 - d^2/r^2)^2 : range에서 정확히 0이 되는 부드러운 감쇠
+    Float4 falloff = max(one - distSq * Float4::splat(1.0f / rangeSqScalar), zero);
+    Float4 attenuation = falloff * falloff * Float4::splat(light.intensity);
+    accumulateLight(material, n, v, toLight,
+                    Float4::splat(light.color.x) * attenuation,
+                    Float4::splat(light.color.y) * attenuation,
+                    Float4::splat(light.color.z) * attenuation, acc);
+  }
+
+  acc.diffuseR = acc.diffuseR * Float4::splat(material.diffuse.x);
+  acc.diffuseG = acc.diffuseG * Float4::splat(material.diffuse.y);
+  acc.diffuseB = acc.diffuseB * Float4::splat(material.diffuse.z);
+  acc.specularR = acc.specularR * Float4::splat(material.specular.x);
+  acc.specularG = acc.specularG * Float4::splat(material.specular.y);
+  acc.specularB = acc.specularB * Float4::splat(material.specular.z);
+}
+
+// 배치에 담긴 월드 좌표의 AABB와 겹치는 점광원만 골라냄
+// 화면 타일 목록은 깊이 방향으로 느슨하므로 (큐브 뒤쪽 광원 등) 배치 단위로 한 번 더 거른다.
+void cullPointLights(const FragmentBatch& batch, const PointLightList& candidates,
+                     std::vector<uint32_t>& out) {
+  float minX = batch.posX[0], maxX = batch.posX[0];
+  float minY = batch.posY[0], maxY = batch.posY[0];
+  float minZ = batch.posZ[0], maxZ = batch.posZ[0];
+  for (int i = 1; i < batch.count; ++i) {
+    minX = std::min(minX, batch.posX[i]); maxX = std::max(maxX, batch.posX[i]);
+    minY = std::min(minY, batch.posY[i]); maxY = std::max(maxY, batch.posY[i]);
+    minZ = std::min(minZ, batch.posZ[i]); maxZ = std::max(maxZ, batch.posZ[i]);
+  }
+
+  out.clear();
+  for (uint32_t p = 0; p < candidates.count; ++p) {
+    const PointLight& light = candidates[p];
+    // 구와 AABB 사이 최단 거리
+    const float dx = std::max(std::max(minX - light.position.x, 0.0f), light.position.x - maxX);
+    const float dy = std::max(std::max(minY - light.position.y, 0.0f), light.position.y - maxY);
+    const float dz = std::max(std::max(minZ - light.position.z, 0.0f), light.position.z - maxZ);
+    if (dx * dx + dy * dy + dz * dz < light.range * light.range) {
+      out.push_back(candidates.indices != nullptr ? candidates.indices[p] : p);
+    }
+  }
+}
+
+// 4의 배수로 맞추기 위해 마지막 프래그먼트를 복제해서 빈 레인을 채움
+void padBatch(FragmentBatch& batch) {
+  const int last = batch.count - 1;
+  const int padded = (batch.count + 3) & ~3;
+  for (int i = batch.count; i < padded; ++i) {
+    batch.albedoR[i] = batch.albedoR[last];
+    batch.albedoG[i] = batch.albedoG[last];
+    batch.albedoB[i] = batch.albedoB[last];
+    batch.posX[i] = batch.posX[last];
+    batch.posY[i] = batch.posY[last];
+    batch.posZ[i] = batch.posZ[last];
+    batch.normalX[i] = batch.normalX[last];
+    batch.normalY[i] = batch.normalY[last];
+    batch.normalZ[i] = batch.normalZ[last];
+    batch.diffuseR[i] = batch.diffuseR[last];
+    batch.diffuseG[i] = batch.diffuseG[last];
+    batch.diffuseB[i] = batch.diffuseB[last];
+    batch.specularR[i] = batch.specularR[last];
+    batch.specularG[i] = batch.specularG[last];
+    batch.specularB[i] = batch.specularB[last];
+  }
+}
+
+}  // namespace
+
+void generateVertexNormals(const std::vector<Vector3>& positions,
+                           const std::vector<uint32_t>& indices,
+                           std::vector<Vector3>& outNormals) {
+  outNormals.assign(positions.size(), Vector3{ 0.0f, 0.0f, 0.0f });
+
+  for (size_t idx = 0; idx + 2 < indices.size(); idx += 3) {
+    const uint32_t i0 = indices[idx];
+    const uint32_t i1 = indices[idx + 1];
+    const uint32_t i2 = indices[idx + 2];
+
+    // 외적의 크기가 면적의 두 배이므로 정규화하지 않고 더하면 면적 가중 평균이 된다
+    Vector3 faceNormal = math::crossProduct(positions[i1] - positions[i0],
+                                            positions[i2] - positions[i0]);
+    outNormals[i0] = outNormals[i0] + faceNormal;
+    outNormals[i1] = outNormals[i1] + faceNormal;
+    outNormals[i2] = outNormals[i2] + faceNormal;
+  }
+
+  for (Vector3& n : outNormals) {
+    if (math::dotProduct(n, n) > 0.0f) {
+      n = n.normalize();
+    } else {
+      n = { 0.0f, 1.0f, 0.0f };
+    }
+  }
+}
+
+void shadeVertices(const LightSet& lights, const Material& material, const Vector3& eye,
+                   const Vector3* positions, const Vector3* normals, size_t count,
+                   Vector3* outDiffuse, Vector3* outSpecular) {
+  std::vector<PreparedDirectional> directionals;
+  prepareDirectionals(lights, directionals);
+  const PointLightList points = { lights.points.data(), nullptr, (uint32_t)lights.points.size() };
+
+  for (size_t base = 0; base < count; base += 4) {
+    const size_t lanes = std::min<size_t>(4, count - base);
+
+    // AoS -> SoA 전치. 남는 레인은 마지막 정점으로 채움
+    float px[4], py[4], pz[4], nx[4], ny[4], nz[4];
+    for (size_t i = 0; i < 4; ++i) {
+      const size_t src = base + std::min(i, lanes - 1);
+      px[i] = positions[src].x; py[i] = positions[src].y; pz[i] = positions[src].z;
+      nx[i] = normals[src].x;   ny[i] = normals[src].y;   nz[i] = normals[src].z;
+    }
+
+    LightAccum acc;
+    evaluateLights(lights, directionals, points, material, eye,
+                   { Float4::load(px), Float4::load(py), Float4::load(pz) },
+                   { Float4::load(nx), Float4::load(ny), Float4::load(nz) }, acc);
+
+    float dr[4], dg[4], db[4], sr[4], sg[4], sb[4];
+    acc.diffuseR.store(dr); acc.diffuseG.store(dg); acc.diffuseB.store(db);
+    acc.specularR.store(sr); acc.specularG.store(sg); acc.specularB.store(sb);
+    for (size_t i = 0; i < lanes; ++i) {
+      outDiffuse[base + i] = { dr[i], dg[i], db[i] };
+      outSpecular[base + i] = { sr[i], sg[i], sb[i] };
+    }
+  }
+}
+
+void shadeFragments(const LightSet& lights, const Material& material, const Vector3& eye,
+                    FragmentBatch& batch) {
+  shadeFragments(lights, material, eye, nullptr, (uint32_t)lights.points.size(), batch);
+}
+
+void shadeFragments(const LightSet& lights, const Material& material, const Vector3& eye,
+                    const uint32_t* pointLightIndices, uint32_t pointLightCount,
+                    FragmentBatch& batch) {
+  if (batch.count == 0) {
+    return;
+  }
+  padBatch(batch);
+
+  static thread_local std::vector<PreparedDirectional> directionals;
+  static thread_local std::vector<uint32_t> visiblePoints;
+  PointLightList points = { lights.points.data(), pointLightIndices, pointLightCount };
+  if (material.frequency == ShadingFrequency::Pixel && !material.emissive) {
+    prepareDirectionals(lights, directionals);
+    cullPointLights(batch, points, visiblePoints);
+    points = { lights.points.data(), visiblePoints.data(), (uint32_t)visiblePoints.size() };
+  }
+
+  // 감마 보정이 켜져 있으면 선형 결과를 12비트로 양자화한 뒤 테이블로 sRGB 인코드
+  const bool encodeSrgb = srgb::enabled();
+  const Float4 scale = Float4::splat(encodeSrgb ? (float)srgb::kLinearMax : 255.0f);
+  const Float4 round = Float4::splat(0.5f);
+
+  for (int base = 0; base < batch.count; base += 4) {
+    Float4 diffuseR, diffuseG, diffuseB, specularR, specularG, specularB;
+
+    if (material.emissive) {
+      // 자체 발광: 알베도를 그대로 출력
+      diffuseR = diffuseG = diffuseB = Float4::splat(1.0f);
+      specularR = specularG = specularB = Float4::splat(0.0f);
+    } else if (material.frequency == ShadingFrequency::Pixel) {
+      LightAccum acc;
+      evaluateLights(lights, directionals, points, material, eye,
+                     { Float4::load(batch.posX + base), Float4::load(batch.posY + base),
+                       Float4::load(batch.posZ + base) },
+                     { Float4::load(batch.normalX + base), Float4::load(batch.normalY + base),
+                       Float4::load(batch.normalZ + base) }, acc);
+      diffuseR = acc.diffuseR; diffuseG = acc.diffuseG; diffuseB = acc.diffuseB;
+      specularR = acc.specularR; specularG = acc.specularG; specularB = acc.specularB;
+    } else {
+      diffuseR = Float4::load(batch.diffuseR + base);
+      diffuseG = Float4::load(batch.diffuseG + base);
+      diffuseB = Float4::load(batch.diffuseB + base);
+      specularR = Float4::load(batch.specularR + base);
+      specularG = Float4::load(batch.specularG + base);
+      specularB = Float4::load(batch.specularB + base);
+    }
+
+    // color = albedo * diffuse + specular
+    Float4 r = Float4::load(batch.albedoR + base) * diffuseR + specularR;
+    Float4 g = Float4::load(batch.albedoG + base) * diffuseG + specularG;
+    Float4 b = Float4::load(batch.albedoB + base) * diffuseB + specularB;
+
+    float outR[4], outG[4], outB[4];
+    (clamp01(r) * scale + round).store(outR);
+    (clamp01(g) * scale + round).store(outG);
+    (clamp01(b) * scale + round).store(outB);
+
+    const int lanes = std::min(4, batch.count - base);
+    if (encodeSrgb) {
+      for (int i = 0; i < lanes; ++i) {
+        batch.color[base + i] = (batch.alpha[base + i] << 24) |
+                                ((uint32_t)srgb::encode12((uint32_t)outR[i]) << 16) |
+                                ((uint32_t)srgb::encode12((uint32_t)outG[i]) << 8) |
+                                (uint32_t)srgb::encode12((uint32_t)outB[i]);
+      }
+    } else {
+      for (int i = 0; i < lanes; ++i) {
+        batch.color[base + i] = (batch.alpha[base + i] << 24) |
+                                ((uint32_t)outR[i] << 16) |
+                                ((uint32_t)outG[i] << 8) |
+                                (uint32_t)outB[i];
+      }
+    }
+  }
+}
+
+}  // namespace lighting
+
+}  // namespace ssr
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+// File: Lighting.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Blend.hpp"
+#include "Math.hpp"
+
+namespace ssr {
+
+class ShadowMap;
+
+/// @brief 빛이 표면에서 어떻게 반사되는지 (반사 모델)
+enum class ReflectionModel {
+  Lambert,      // 확산광만
+  HalfLambert,  // (N·L * 0.5 + 0.5)^2, 뒷면까지 부드럽게 감싸는 확산광
+  Phong,        // 확산광 + 반사 벡터 R 기반 정반사
+  BlinnPhong,   // 확산광 + 하프 벡터 H 기반 정반사
+};
+
+/// @brief 라이팅을 어느 빈도로 계산하는지
+/// Flat: 삼각형마다 한 번, Vertex: 정점마다 계산 후 보간 (Gouraud), Pixel: 픽셀마다 계산
+enum class ShadingFrequency {
+  Flat,
+  Vertex,
+  Pixel,
+};
+
+/// @brief 알베도를 어디서 가져오는지
+/// Textured: 메시 텍스처, Water / Fire: 미리 만든 노이즈 볼륨을 샘플링하는 표면 셰이더
+enum class SurfaceType {
+  Textured,
+  Water,
+  Fire,
+};
+
+const char* toString(ReflectionModel model);
+const char* toString(ShadingFrequency frequency);
+const char* toString(SurfaceType surface);
+
+/// @brief 메시 단위 재질. 반사 모델과 계산 빈도를 재질마다 고를 수 있다.
+/// 로드맵 항목과의 대응:
+///   Flat-Shading       = Lambert + Flat
+///   Gouraud Shading    = Lambert + Vertex
+///   Half Lambert       = HalfLambert + (Vertex | Pixel)
+///   Phong Shading      = Phong + Pixel
+///   BlinnPhong Shading = BlinnPhong + Pixel
+struct Material {
+  ReflectionModel model = ReflectionModel::BlinnPhong;
+  ShadingFrequency frequency = ShadingFrequency::Pixel;
+  Vector3 diffuse = { 1.0f, 1.0f, 1.0f };
+  Vector3 specular = { 0.5f, 0.5f, 0.5f };
+  float shininess = 32.0f;
+  SurfaceType surface = SurfaceType::Textured;
+  // true면 라이팅 없이 알베도를 그대로 출력 (불꽃처럼 스스로 빛나는 표면)
+  bool emissive = false;
+  // Opaque가 아니면 프레임버퍼와 블렌딩하고 깊이는 기록하지 않는다
+  BlendMode blend = BlendMode::Opaque;
+};
+
+/// @brief 방향광. direction은 빛이 진행하는 방향 (광원 -> 표면)
+struct DirectionalLight {
+  Vector3 direction = { 0.0f, -1.0f, 0.0f };
+  Vector3 color = { 1.0f, 1.0f, 1.0f };
+  float intensity = 1.0f;
+  // nullptr 이 아니면 라이팅 시 그림자 맵 가시도를 곱한다
+  const ShadowMap* shadowMap = nullptr;
+};
+
+/// @brief 점광원. range 밖에서는 감쇠가 정확히 0이 된다.
+struct PointLight {
+  Vector3 position;
+  Vector3 color = { 1.0f, 1.0f, 1.0f };
+  float intensity = 1.0f;
+  float range = 5.0f;
+};
+
+struct LightSet {
+  Vector3 ambient = { 0.08f, 0.08f, 0.08f };
+  std::vector<DirectionalLight> directionals;
+  std::vector<PointLight> points;
+};
+
+namespace lighting {
+
+/// @brief 인덱스 삼각형 목록으로부터 정점 노멀 생성
+/// 면 노멀(외적)을 면적 가중치 그대로 누적한 뒤 정규화한다.
+/// 감기 순서는 Left-handed 기준 시계 방향이 앞면이다.
+void generateVertexNormals(const std::vector<Vector3>& positions,
+                           const std::vector<uint32_t>& indices,
+                           std::vector<Vector3>& outNormals);
+
+/// @brief 정점(혹은 면) 배치 단위 라이팅. 4개씩 묶어 SIMD로 계산한다.
+/// 결과는 알베도에 곱할 확산광(앰비언트 포함)과 더할 정반사광으로 나눠서 반환
+void shadeVertices(const LightSet& lights, const Material& material, const Vector3& eye,
+                   const Vector3* positions, const Vector3* normals, size_t count,
+                   Vector3* outDiffuse, Vector3* outSpecular);
+
+/// @brief 래스터라이저가 깊이 테스트를 통과시킨 픽셀을 모아두는 SoA 버퍼
+/// 가득 차거나 삼각형이 끝나면 shadeFragments로 한 번에 셰이딩한다.
+struct FragmentBatch {
+  static constexpr int kCapacity = 64;
+
+  int count = 0;
+  uint32_t pixel[kCapacity];
+
+  float albedoR[kCapacity], albedoG[kCapacity], albedoB[kCapacity];
+  uint32_t alpha[kCapacity];
+  // NDC 깊이 [0, 1]. 반투명 패스(WeightedBlendedOIT)의 가중치에 사용
+  float depth[kCapacity];
+  // MSAA 샘플 중 깊이 테스트를 통과한 것 (비트 s = 샘플 s). 셰이딩은 픽셀당 한 번
+  uint8_t coverage[kCapacity];
+  // 렌더 타깃 샘플 평면에서 이 픽셀의 첫 샘플 위치 (FrameBuffer::sampleIndex). pixel은 행 우선 인덱스
+  uint32_t sample[kCapacity];
+
+  // ShadingFrequency::Pixel: 보간된 월드 좌표 / 노멀
+  float posX[kCapacity], posY[kCapacity], posZ[kCapacity];
+  float normalX[kCapacity], normalY[kCapacity], normalZ[kCapacity];
+
+  // ShadingFrequency::Vertex, Flat: 보간된 정점 라이팅 결과
+  float diffuseR[kCapacity], diffuseG[kCapacity], diffuseB[kCapacity];
+  float specularR[kCapacity], specularG[kCapacity], specularB[kCapacity];
+
+  // 결과 (0xAARRGGBB)
+  uint32_t color[kCapacity];
+
+  bool full() const { return count == kCapacity; }
+};
+
+/// @brief 배치에 쌓인 프래그먼트를 4개씩 SIMD로 셰이딩해서 color[]를 채운다.
+void shadeFragments(const LightSet& lights, const Material& material, const Vector3& eye,
+                    FragmentBatch& batch);
+
+/// @brief 점광원 중 pointLightIndices에 있는 것만 평가하는 버전
+/// 타일 단위 컬링(TiledLightGrid) 결과를 넘길 때 사용. 방향광은 항상 모두 평가한다.
+void shadeFragments(const LightSet& lights, const Material& material, const Vector3& eye,
+                    const uint32_t* pointLightIndices, uint32_t pointLightCount,
+                    FragmentBatch& batch);
+
+}  // namespace lighting
+
+}  // namespace ssr
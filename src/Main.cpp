@@ -11,50 +11,332 @@
 #include <iostream>
 #include <memory>
 #include <cstring>
+#include <string>
 #include <vector>
 #include <cstdint>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <mutex>
+#include <thread>
 
 #include "SDLProgram.hpp"
 #include "Math.hpp"
+#include "Blend.hpp"
+#include "Bloom.hpp"
 #include "Camera.hpp"
+#include "ColorSpace.hpp"
+#include "Depth.hpp"
+#include "FrameBuffer.hpp"
+#include "FrameExporter.hpp"
+#include "FramePacer.hpp"
+#include "Fxaa.hpp"
+#include "Lighting.hpp"
+#include "LightCulling.hpp"
+#include "Multisample.hpp"
+#include "SIMD.hpp"
+#include "ShadowMap.hpp"
+#include "SurfaceShaders.hpp"
+#include "PostProcess.hpp"
+#include "TemporalAA.hpp"
+#include "ThreadPool.hpp"
+#include "Transparency.hpp"
+#include "TripleBuffer.hpp"
 
 #define Z_NEAR 0.1f
 #define Z_FAR  10.0f
-#define SCREEN_WIDTH 720
-#define SCREEN_HEIGHT 640
 
 #pragma mark Global Variables
 
 // Global variables
+// 화면(프레임버퍼) 크기. 헤드리스 모드는 SSR_SIM_SIZE로 정한다
+constexpr int kDefaultScreenWidth = 720;
+constexpr int kDefaultScreenHeight = 640;
+int g_screenWidth = kDefaultScreenWidth;
+int g_screenHeight = kDefaultScreenHeight;
 ssr::Matrix4x4 g_cameraMat = ssr::Matrix4x4::identity;
 ssr::Matrix4x4 g_projectionMat = ssr::Matrix4x4::identity;
 ssr::Matrix4x4 g_viewportMat = ssr::Matrix4x4::identity;
+// 이번 프레임 래스터화에 쓰는 투영 행렬. TAA가 켜져 있으면 g_projectionMat에 서브픽셀 지터를 더한 사본
+ssr::Matrix4x4 g_renderProjectionMat = ssr::Matrix4x4::identity;
 
 ssr::SDLProgram *g_program;
 SDL_Texture* g_screenTexture;
+// 화면 텍스처의 형식 / 크기. 창 크기가 바뀌면 ensureScreenTexture가 새 크기로 다시 만든다
+Uint32 g_screenTextureFormat = SDL_PIXELFORMAT_ARGB8888;
+int g_screenTextureWidth = 0;
+int g_screenTextureHeight = 0;
 
 ssr::Camera g_camera;
-unsigned int* g_frameBuffer = nullptr;
-std::vector<float> g_depthBuffer;
+// 렌더 타깃. 불투명 메시는 샘플 색 / 깊이 평면에 그리고, 리졸브한 출력 평면 위에 반투명을 합성한다
+// 샘플 평면은 기본 8x8 타일 우선 배치, 환경 변수 SSR_TILED=0 이면 행 우선
+ssr::FrameBuffer g_frameBuffer;
+ssr::FrameBuffer::Layout g_frameBufferLayout = ssr::FrameBuffer::Layout::Tiled;
+int g_msaaSamples = 4;
+// 깊이 평면 형식과 비교 함수. 환경 변수 SSR_DEPTH / SSR_DEPTH_COMPARE, Z 키로 형식 순환
+// 뒤집은 형식(ReversedFloat32)이면 투영 행렬도 뒤집은 것을 쓴다
+ssr::DepthFormat g_depthFormat = ssr::DepthFormat::Float32;
+ssr::DepthCompare g_depthCompare = ssr::DepthCompare::Less;
+// 8x8 블록마다 가장 먼 깊이로 블록 / 삼각형을 픽셀 단위 작업 전에 버린다. 환경 변수 SSR_HIZ=0 이면 끔 (비교 측정용)
+bool g_hiZEnabled = true;
+// HiZ 판정에서 삼각형 깊이를 가까운 쪽으로 당기는 여유 (NDC). 모서리 평가와 샘플 보간의 반올림 차이를 덮는다
+const float kHiZSlack = 1e-5f;
+struct HiZStats {
+  int culledTriangles = 0;
+  int culledBlocks = 0;
+  int drawnBlocks = 0;
+};
+HiZStats g_hiZStats;
+
+// 화면 출력 방식
+//   Lock: 후처리 체인이 픽셀 패스 묶음(톤 매핑 / 색 보정 / 비네트)으로 끝나는 프레임은 스트리밍 텍스처를 잠그고
+//         그 묶음의 인코드가 텍스처에 바로 쓴다 (출력 평면 -> 텍스처 복사 없음, 기본). 그 밖의 프레임은 Copy와 같다.
+//         잠근 메모리는 쓰기 전용이라 (백엔드에 따라 캐시되지 않는 write-combined) 합성 / 블렌딩 / 후처리의 읽기는 출력 평면에서
+//   Copy: 내부 출력 평면에 그린 뒤 SDL_UpdateTexture로 복사. 환경 변수 SSR_PRESENT=copy
+//   Surface: SDL_Renderer 없이 창 표면에 바로 쓰고 SDL_UpdateWindowSurface. 환경 변수 SSR_PRESENT=surface
+enum class PresentMode {
+  Lock,
+  Copy,
+  Surface,
+};
+PresentMode g_presentMode = PresentMode::Lock;
+
+// 렌더 / 출력 파이프라인. 환경 변수 SSR_PIPELINE=1
+// 렌더 스레드가 프레임 N+1을 그리는 동안 메인 스레드가 프레임 N을 올리고 내보낸다. 완성된 프레임은 트리플 버퍼로 넘긴다
+bool g_pipelined = false;
+ssr::TripleBuffer g_presentFrames;
+std::atomic<bool> g_renderThreadStop{ false };
+// 메인 스레드가 받은 키 입력. 렌더 스레드가 프레임 시작 때 가져가서 처리한다
+std::mutex g_pendingEventsMutex;
+std::vector<SDL_Event> g_pendingEvents;
+
+// 프레임 제한. 환경 변수 SSR_FPS=60 (목표 fps) / vsync / 0 (제한 없음, 기본)
+// 파이프라인이면 출력 스레드(메인 스레드)의 present 간격을 맞춘다
+ssr::FramePacer g_framePacer;
+
+// 완성된 프레임을 백그라운드에서 PNG / PPM 연속 파일이나 Y4M / RGB 스트림으로 내보낸다
+// 창 모드는 환경 변수 SSR_EXPORT=path, 헤드리스 모드는 SSR_SIM_OUTPUT=path
+ssr::FrameExporter g_exporter;
+
+// 후처리 패스가 행 묶음을 나눠 돌리는 스레드 풀
+std::unique_ptr<ssr::ThreadPool> g_threadPool;
+// 샘플 버퍼 없이 최종 프레임버퍼만 보는 안티에일리어싱. MSAA 대신 쓸 때 켠다
+ssr::Fxaa g_fxaa;
+bool g_fxaaEnabled = false;
+// 지터 + 히스토리 재투영. 멈춰 있는 장면에서 여러 프레임에 걸쳐 슈퍼샘플링한 효과
+ssr::TemporalAA g_taa;
+bool g_taaEnabled = false;
+// 밝은 부분(불꽃, 하이라이트)이 주변으로 번지는 효과
+ssr::Bloom g_bloom;
+bool g_bloomEnabled = false;
+// 후처리 체인: TAA -> 블룸 -> 톤 매핑 + 색 보정 + 비네트 (한 번에 훑음) -> FXAA
+ssr::PostProcessChain g_postProcess;
+ssr::post::ToneMapping g_toneMapping;
+ssr::post::ColorGrading g_colorGrading;
+ssr::post::Vignette g_vignette;
+bool g_gradingEnabled = false;
+// 화면 텍스처 / 창 표면 형식이 ABGR8888 / BGR888일 때만 켜진다 (SDLRenderer::isDirectFormat)
+// 따로 훑지 않고 최종 결과를 쓰는 곳(후처리의 마지막 인코드 / 텍스처로 복사)에서 바꿔 쓴다
+bool g_swapRedBlue = false;
+// 잠근 화면 텍스처 (PresentMode::Lock). drawFrame의 마지막 훑기만 여기에 쓴다. 한 행 g_presentTargetPitch개
+uint32_t* g_presentTarget = nullptr;
+int g_presentTargetPitch = 0;
 std::vector<float> g_invWs;
-std::vector<float> g_clipZs;
 bool g_logThisFrame = false;
 
+const int TEX_W = 256, TEX_H = 256;
+struct SimpleMesh {
+  std::vector<ssr::Vector3> vertices;
+  std::vector<uint32_t> indices;
+  std::vector<ssr::Vector2> uvs;
+  // 비어 있으면 initMesh에서 면 노멀로부터 생성
+  std::vector<ssr::Vector3> normals;
+  std::vector<uint32_t> texture;
+  ssr::Material material;
+  ssr::Matrix4x4 modelMat = ssr::Matrix4x4::identity;
+  bool castsShadows = true;
+};
+
+SimpleMesh g_mesh;
+SimpleMesh g_groundMesh;
+SimpleMesh g_waterMesh;
+SimpleMesh g_fireMesh;
+// 물 / 불 애니메이션 시간 (초)
+float g_sceneTimeSeconds = 0.0f;
+ssr::LightSet g_lights;
+ssr::TiledLightGrid g_lightGrid;
+bool g_nightScene = false;
+
+// 방향광 그림자 맵. 큐브와 바닥 주변을 덮는 구를 기준으로 직교 투영
+const int kShadowMapSize = 1024;
+const ssr::Vector3 kShadowCenter = { 0.0f, -0.5f, 0.5f };
+const float kShadowRadius = 3.5f;
+ssr::ShadowMap g_shadowMap;
+bool g_shadowsEnabled = true;
+
+// 알파 블렌딩 재질(물)의 순서 독립 반투명 누적 버퍼
+ssr::WeightedBlendedOIT g_oit;
+
 bool isSimTestEnabled() {
   const char* env = std::getenv("SSR_SIM_TEST");
   return env != nullptr &&
          (strcmp(env, "1") == 0 || strcmp(env, "true") == 0 || strcmp(env, "TRUE") == 0);
 }
 
+// SSR_TILED=0 / false 이면 샘플 평면을 행 우선으로 (비교 측정용)
+ssr::FrameBuffer::Layout frameBufferLayoutFromEnv() {
+  const char* env = std::getenv("SSR_TILED");
+  const bool linear = env != nullptr &&
+                      (strcmp(env, "0") == 0 || strcmp(env, "false") == 0 || strcmp(env, "FALSE") == 0);
+  return linear ? ssr::FrameBuffer::Layout::Linear : ssr::FrameBuffer::Layout::Tiled;
+}
+
+// SSR_DEPTH=unorm16 / unorm24 / float32 / reversed, SSR_DEPTH_COMPARE=less / lequal / greater / ...
+// 비교 함수를 주지 않으면 형식의 기본값 (뒤집은 형식은 greater)
+void depthStateFromEnv() {
+  const char* format = std::getenv("SSR_DEPTH");
+  if (format != nullptr && !ssr::depth::parse(format, g_depthFormat)) {
+    printf("SSR_DEPTH: unknown depth format '%s', using %s\n", format, ssr::depth::toString(g_depthFormat));
+  }
+  g_depthCompare = ssr::depth::defaultCompare(g_depthFormat);
+  const char* compare = std::getenv("SSR_DEPTH_COMPARE");
+  if (compare != nullptr && !ssr::depth::parse(compare, g_depthCompare)) {
+    printf("SSR_DEPTH_COMPARE: unknown compare '%s', using %s\n", compare, ssr::depth::toString(g_depthCompare));
+  }
+}
+
+// 깊이 형식에 맞는 원근 투영 (뒤집은 깊이면 near -> 1, far -> 0)
+void setupProjection() {
+  g_projectionMat = ssr::Matrix4x4::identity;
+  if (ssr::depth::isReversed(g_depthFormat)) {
+    ssr::math::setupReversedPerspectiveProjectionMatrix(g_projectionMat, g_camera.m_fov, g_camera.m_aspect,
+                                                        Z_NEAR, Z_FAR);
+  } else {
+    ssr::math::setupPerspectiveProjectionMatrix(g_projectionMat, g_camera.m_fov, g_camera.m_aspect, Z_NEAR, Z_FAR);
+  }
+}
+
+PresentMode presentModeFromEnv() {
+  const char* env = std::getenv("SSR_PRESENT");
+  if (env == nullptr) {
+    return PresentMode::Lock;
+  }
+  if (strcmp(env, "copy") == 0 || strcmp(env, "COPY") == 0) {
+    return PresentMode::Copy;
+  }
+  if (strcmp(env, "surface") == 0 || strcmp(env, "SURFACE") == 0) {
+    return PresentMode::Surface;
+  }
+  return PresentMode::Lock;
+}
+
+const char* toString(PresentMode mode) {
+  switch (mode) {
+  case PresentMode::Lock: return "SDL_LockTexture when the last post pass can write it, else SDL_UpdateTexture";
+  case PresentMode::Copy: return "SDL_UpdateTexture";
+  case PresentMode::Surface: return "window surface";
+  }
+  return "Unknown";
+}
+
+// 창 표면을 잠그고, 형식과 크기가 맞으면 리졸브 / 합성 / 후처리가 표면 메모리에 바로 쓰게 한다
+// 맞지 않으면 내부 출력 평면에 그리고 presentWindowSurface가 SDL_ConvertPixels로 옮긴다
+SDL_Surface* bindWindowSurface(ssr::SDLRenderer& renderer) {
+  SDL_Surface* surface = renderer.windowSurface();
+  g_swapRedBlue = false;
+  if (surface == nullptr || (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0)) {
+    return nullptr;
+  }
+  bool swapRedBlue = false;
+  if (surface->w == g_screenWidth && surface->h == g_screenHeight && surface->pitch % 4 == 0 &&
+      ssr::SDLRenderer::isDirectFormat(surface->format->format, swapRedBlue)) {
+    g_frameBuffer.bindOutput(static_cast<uint32_t*>(surface->pixels), surface->pitch / 4);
+    g_swapRedBlue = swapRedBlue;
+  }
+  return surface;
+}
+
+void presentWindowSurface(SDL_Surface* surface) {
+  if (surface == nullptr) {
+    return;
+  }
+  if (g_frameBuffer.isOutputBound()) {
+    g_frameBuffer.bindOutput(nullptr, 0);
+  } else {
+    SDL_ConvertPixels(std::min(surface->w, g_screenWidth), std::min(surface->h, g_screenHeight),
+                      SDL_PIXELFORMAT_ARGB8888, g_frameBuffer.output(), g_frameBuffer.outputPitch() * 4,
+                      surface->format->format, surface->pixels, surface->pitch);
+  }
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_UnlockSurface(surface);
+  }
+}
+
+// SSR_FPS를 읽어 g_framePacer를 설정한다. vsync는 렌더러가 지원할 때만, 아니면 화면 주사율을 목표로 한 Fixed
+void framePacingFromEnv(ssr::SDLRenderer& renderer) {
+  const char* env = std::getenv("SSR_FPS");
+  if (env == nullptr) {
+    g_framePacer.configure(ssr::FramePacer::Mode::Unlimited, 0.0);
+    return;
+  }
+  if (strcmp(env, "vsync") == 0 || strcmp(env, "VSYNC") == 0) {
+    SDL_DisplayMode mode;
+    const double refreshRate =
+        SDL_GetWindowDisplayMode(g_program->window(), &mode) == 0 && mode.refresh_rate > 0 ? mode.refresh_rate : 60.0;
+    g_framePacer.configure(renderer.setVSync(true) ? ssr::FramePacer::Mode::VSync : ssr::FramePacer::Mode::Fixed,
+                           refreshRate);
+    return;
+  }
+  g_framePacer.configure(ssr::FramePacer::Mode::Fixed, std::atof(env));
+}
+
+// 놓친 마감 보고. 약 1초(목표 fps 프레임)마다, 그 사이 놓친 것이 있을 때만 한 줄. 전체 합계는 끝날 때
+void reportFramePacing(bool missed) {
+  static uint64_t s_windowFrames = 0;
+  static uint64_t s_windowMissed = 0;
+  static double s_windowWorstMs = 0.0;
+  ++s_windowFrames;
+  if (missed) {
+    ++s_windowMissed;
+    s_windowWorstMs = std::max(s_windowWorstMs, g_framePacer.lastLateMs());
+  }
+  if ((double)s_windowFrames < g_framePacer.targetFps()) {
+    return;
+  }
+  if (s_windowMissed > 0) {
+    printf("frame pacer: %llu / %llu deadlines missed (worst +%.2f ms)\n", (unsigned long long)s_windowMissed,
+           (unsigned long long)s_windowFrames, s_windowWorstMs);
+  }
+  s_windowFrames = 0;
+  s_windowMissed = 0;
+  s_windowWorstMs = 0.0;
+}
+
+void logFramePacingSummary() {
+  if (g_framePacer.mode() == ssr::FramePacer::Mode::Unlimited) {
+    return;
+  }
+  printf("frame pacer: %s %.1f fps, %llu frames, %llu missed (worst +%.2f ms), spin margin %.2f ms\n",
+         ssr::toString(g_framePacer.mode()), g_framePacer.targetFps(), (unsigned long long)g_framePacer.frames(),
+         (unsigned long long)g_framePacer.missedFrames(), g_framePacer.worstLateMs(), g_framePacer.spinMarginMs());
+}
+
+bool pipelineEnabledFromEnv() {
+  const char* env = std::getenv("SSR_PIPELINE");
+  return env != nullptr && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0 || strcmp(env, "TRUE") == 0);
+}
+
+bool hiZEnabledFromEnv() {
+  const char* env = std::getenv("SSR_HIZ");
+  return !(env != nullptr && (strcmp(env, "0") == 0 || strcmp(env, "false") == 0 || strcmp(env, "FALSE") == 0));
+}
+
 void initMatrices(float width, float height) {
 	// 뷰 행렬
 	ssr::math::setupCameraMatrix(g_cameraMat, g_camera.m_eye, g_camera.m_at, g_camera.m_up);
 
 	// 프로젝션 행렬
-	ssr::math::setupPerspectiveProjectionMatrix(g_projectionMat, g_camera.m_fov,
-		g_camera.m_aspect, Z_NEAR, Z_FAR);
+	setupProjection();
 
 	// 뷰포트 행렬
 	ssr::math::setupViewportMatrix(g_viewportMat, 0, 0,
@@ -78,23 +360,21 @@ void transformToScreen(ssr::Vector4& point) {
   point = g_viewportMat * point;
 }
 
+void initLights();
+
 void handleKeyInput(SDL_Event event)
 {
   switch (event.key.keysym.sym)
   {
   case SDLK_UP: {
     g_camera.m_fov++;
-    g_projectionMat = ssr::Matrix4x4::identity;
-    ssr::math::setupPerspectiveProjectionMatrix(
-      g_projectionMat, g_camera.m_fov, g_camera.m_aspect, Z_NEAR, Z_FAR);
+    setupProjection();
     printf("Key Input: SDLK_UP => Camera FOV changed %.1f\n", g_camera.m_fov);
     break;
   }
   case SDLK_DOWN: {
     g_camera.m_fov--;
-    g_projectionMat = ssr::Matrix4x4::identity;
-    ssr::math::setupPerspectiveProjectionMatrix(
-      g_projectionMat, g_camera.m_fov, g_camera.m_aspect, Z_NEAR, Z_FAR);
+    setupProjection();
     printf("Key Input: SDLK_DOWN => Camera FOV changed %.1f\n", g_camera.m_fov);
     break;
   }
@@ -116,9 +396,7 @@ void handleKeyInput(SDL_Event event)
   }
   case SDLK_r: {
     g_camera.m_fov = 45.0f;
-    g_projectionMat = ssr::Matrix4x4::identity;
-    ssr::math::setupPerspectiveProjectionMatrix(
-      g_projectionMat, g_camera.m_fov, g_camera.m_aspect, Z_NEAR, Z_FAR);
+    setupProjection();
 
     g_camera.m_eye.x = 0.0f;
     g_camera.m_eye.y = 0.0f;
@@ -133,6 +411,90 @@ void handleKeyInput(SDL_Event event)
     printf("Key Input: SDLK_r => Camera settings set to default\n");
     break;
   }
+  case SDLK_m: {
+    // Lambert -> HalfLambert -> Phong -> BlinnPhong 순환
+    ssr::Material& material = g_mesh.material;
+    material.model = (ssr::ReflectionModel)(((int)material.model + 1) % 4);
+    printf("Key Input: SDLK_m => Reflection model changed %s\n", ssr::toString(material.model));
+    break;
+  }
+  case SDLK_n: {
+    // 작은 점광원 수백 개가 있는 야간 씬 전환
+    g_nightScene = !g_nightScene;
+    initLights();
+    printf("Key Input: SDLK_n => Night scene %s (%zu point lights)\n",
+           g_nightScene ? "on" : "off", g_lights.points.size());
+    break;
+  }
+  case SDLK_f: {
+    // Flat -> Vertex(Gouraud) -> Pixel 순환
+    ssr::Material& material = g_mesh.material;
+    material.frequency = (ssr::ShadingFrequency)(((int)material.frequency + 1) % 3);
+    printf("Key Input: SDLK_f => Shading frequency changed %s\n", ssr::toString(material.frequency));
+    break;
+  }
+  case SDLK_g: {
+    // 감마 보정(sRGB) 파이프라인 on / off
+    // 기본 켜짐, 환경 변수 SSR_SRGB=0 이면 꺼진 상태로 시작
+    ssr::srgb::setEnabled(!ssr::srgb::enabled());
+    printf("Key Input: SDLK_g => sRGB pipeline %s\n", ssr::srgb::enabled() ? "on" : "off");
+    break;
+  }
+  case SDLK_a: {
+    // MSAA 4x <-> 1x
+    g_msaaSamples = g_msaaSamples == 4 ? 1 : 4;
+    printf("Key Input: SDLK_a => MSAA %dx\n", g_msaaSamples);
+    break;
+  }
+  case SDLK_x: {
+    // FXAA on / off
+    g_fxaaEnabled = !g_fxaaEnabled;
+    printf("Key Input: SDLK_x => FXAA %s\n", g_fxaaEnabled ? "on" : "off");
+    break;
+  }
+  case SDLK_z: {
+    // 깊이 형식 순환: Float32 -> ReversedFloat32 -> Unorm24 -> Unorm16. 비교 함수는 형식의 기본값으로
+    switch (g_depthFormat) {
+    case ssr::DepthFormat::Float32: g_depthFormat = ssr::DepthFormat::ReversedFloat32; break;
+    case ssr::DepthFormat::ReversedFloat32: g_depthFormat = ssr::DepthFormat::Unorm24; break;
+    case ssr::DepthFormat::Unorm24: g_depthFormat = ssr::DepthFormat::Unorm16; break;
+    case ssr::DepthFormat::Unorm16: g_depthFormat = ssr::DepthFormat::Float32; break;
+    }
+    g_depthCompare = ssr::depth::defaultCompare(g_depthFormat);
+    setupProjection();
+    g_oit.setDepthRange(Z_NEAR, Z_FAR, ssr::depth::isReversed(g_depthFormat));
+    // 투영이 바뀌면 이전 프레임 재투영이 맞지 않으므로 히스토리를 버린다
+    g_taa.reset();
+    printf("Key Input: SDLK_z => depth %s, compare %s\n", ssr::depth::toString(g_depthFormat),
+           ssr::depth::toString(g_depthCompare));
+    break;
+  }
+  case SDLK_t: {
+    // TAA on / off. 켤 때마다 이전 히스토리는 버린다
+    g_taaEnabled = !g_taaEnabled;
+    g_taa.reset();
+    printf("Key Input: SDLK_t => TAA %s\n", g_taaEnabled ? "on" : "off");
+    break;
+  }
+  case SDLK_p: {
+    // 톤 매핑 / 색 보정 / 비네트 on / off
+    g_gradingEnabled = !g_gradingEnabled;
+    printf("Key Input: SDLK_p => Color grading %s\n", g_gradingEnabled ? "on" : "off");
+    break;
+  }
+  case SDLK_b: {
+    // 블룸 on / off
+    g_bloomEnabled = !g_bloomEnabled;
+    printf("Key Input: SDLK_b => Bloom %s\n", g_bloomEnabled ? "on" : "off");
+    break;
+  }
+  case SDLK_h: {
+    // 방향광 그림자 on / off
+    g_shadowsEnabled = !g_shadowsEnabled;
+    initLights();
+    printf("Key Input: SDLK_h => Shadows %s\n", g_shadowsEnabled ? "on" : "off");
+    break;
+  }
   default: break;
   }
   g_logThisFrame = true;
@@ -140,24 +502,24 @@ void handleKeyInput(SDL_Event event)
 
 #pragma mark Game Logic
 
-const int TEX_W = 256, TEX_H = 256;
-struct SimpleMesh {
-  std::vector<ssr::Vector3> vertices;
-  std::vector<uint32_t> indices;
-  std::vector<ssr::Vector2> uvs;
-  std::vector<uint32_t> texture;
-};
-
-SimpleMesh g_mesh;
 std::vector<ssr::Vector3> g_transformedVerts;
+std::vector<ssr::Vector3> g_worldPositions;
+std::vector<ssr::Vector3> g_worldNormals;
+std::vector<ssr::Vector3> g_vertexDiffuse;
+std::vector<ssr::Vector3> g_vertexSpecular;
+std::vector<ssr::Vector3> g_faceCentroids;
+std::vector<ssr::Vector3> g_faceNormals;
+std::vector<ssr::Vector3> g_faceDiffuse;
+std::vector<ssr::Vector3> g_faceSpecular;
+ssr::lighting::FragmentBatch g_fragments;
 float g_meshRotationDeg = 0.0f;
 const float g_meshRotationSpeedDegPerSec = 25.0f;
 
 void drawPoint(int x, int y, int color) {
-  if (x > SCREEN_WIDTH || x < 0) return;
-  if (y > SCREEN_HEIGHT || y < 0) return;
+  if (x >= g_screenWidth || x < 0) return;
+  if (y >= g_screenHeight || y < 0) return;
 
-  g_frameBuffer[x + y * SCREEN_WIDTH] = color;
+  g_frameBuffer.output()[x + y * g_frameBuffer.outputPitch()] = color;
 }
 
 std::vector<uint32_t> createProceduralTexture() {
@@ -174,6 +536,19 @@ std::vector<uint32_t> createProceduralTexture() {
   return texture;
 }
 
+// 바닥용 체커 텍스처
+std::vector<uint32_t> createCheckerTexture() {
+  std::vector<uint32_t> texture(TEX_W * TEX_H);
+  const int cell = TEX_W / 8;
+  for (int y = 0; y < TEX_H; ++y) {
+    for (int x = 0; x < TEX_W; ++x) {
+      const bool odd = ((x / cell) + (y / cell)) & 1;
+      texture[x + y * TEX_W] = odd ? 0xFF8C8C8C : 0xFFD8D8D8;
+    }
+  }
+  return texture;
+}
+
 void simulateInputForFrame(int frame) {
   SDL_Event event{};
   event.type = SDL_KEYDOWN;
@@ -224,18 +599,84 @@ static uint32_t sampleTexture(const std::vector<uint32_t>& texture, float u, flo
   return texture[tx + ty * TEX_W];
 }
 
+// 래스터라이저로 넘기는 정점 하나의 정보
+struct RasterVertex {
+  ssr::Vector3 screen;    // 뷰포트 변환까지 마친 좌표, z는 NDC 깊이 [0, 1]
+  float invW = 0.0f;      // 원근 보정용 1/w
+  ssr::Vector2 uv;
+  ssr::Vector3 world;     // ShadingFrequency::Pixel 에서 사용하는 월드 좌표
+  ssr::Vector3 normal;    // ShadingFrequency::Pixel 에서 사용하는 월드 노멀
+  ssr::Vector3 diffuse;   // ShadingFrequency::Vertex, Flat 에서 미리 계산된 라이팅
+  ssr::Vector3 specular;
+};
+
+// 모아둔 프래그먼트를 한 번에 셰이딩해서 프레임버퍼에 기록
+// 픽셀 단위 라이팅은 해당 화면 타일에 걸친 점광원만 평가
+static void flushFragments(const ssr::Material& material, int tile) {
+  if (g_fragments.count == 0) {
+    return;
+  }
+  if (material.frequency == ssr::ShadingFrequency::Pixel) {
+    ssr::lighting::shadeFragments(g_lights, material, g_camera.m_eye,
+                                  g_lightGrid.tileLights(tile), g_lightGrid.tileLightCount(tile),
+                                  g_fragments);
+  } else {
+    ssr::lighting::shadeFragments(g_lights, material, g_camera.m_eye, g_fragments);
+  }
+  if (material.blend == ssr::BlendMode::Opaque) {
+    // 셰이딩 결과 하나를 깊이 테스트를 통과한 샘플에 복사
+    const int samples = g_msaaSamples;
+    uint32_t* colorSamples = g_frameBuffer.colorSamples();
+    for (int i = 0; i < g_fragments.count; ++i) {
+      uint32_t* dst = colorSamples + g_fragments.sample[i];
+      const uint32_t coverage = g_fragments.coverage[i];
+      for (int sample = 0; sample < samples; ++sample) {
+        if (coverage & (1u << sample)) {
+          dst[sample] = g_fragments.color[i];
+        }
+      }
+    }
+  } else if (material.blend == ssr::BlendMode::Alpha ||
+             material.blend == ssr::BlendMode::PremultipliedAlpha) {
+    // "over" 블렌딩은 순서에 따라 결과가 달라지므로 OIT 버퍼에 누적하고 나중에 한 번에 합성
+    g_oit.accumulate(g_fragments, material.blend == ssr::BlendMode::PremultipliedAlpha);
+  } else {
+    // Additive, Multiply는 교환 법칙이 성립하므로 바로 블렌딩해도 순서와 무관
+    // 배치 안의 픽셀은 한 삼각형 / 한 타일에서 나와 겹치지 않으므로 모아서 span 블렌딩 후 되돌려 씀
+    // pixel은 행 우선(한 행 g_screenWidth) 인덱스. 출력이 잠근 텍스처라 행 간격이 다르면 옮겨서 쓴다
+    uint32_t* output = g_frameBuffer.output();
+    const uint32_t pitch = (uint32_t)g_frameBuffer.outputPitch();
+    const uint32_t width = (uint32_t)g_screenWidth;
+    uint32_t offset[ssr::lighting::FragmentBatch::kCapacity];
+    uint32_t dst[ssr::lighting::FragmentBatch::kCapacity];
+    for (int i = 0; i < g_fragments.count; ++i) {
+      const uint32_t pixel = g_fragments.pixel[i];
+      offset[i] = pitch == width ? pixel : (pixel / width) * pitch + pixel % width;
+      dst[i] = output[offset[i]];
+    }
+    if (ssr::srgb::enabled()) {
+      ssr::Blend::spanSrgb(material.blend, g_fragments.color, dst, (size_t)g_fragments.count);
+    } else {
+      ssr::Blend::span(material.blend, g_fragments.color, dst, (size_t)g_fragments.count);
+    }
+    for (int i = 0; i < g_fragments.count; ++i) {
+      output[offset[i]] = dst[i];
+    }
+  }
+  g_fragments.count = 0;
+}
+
 // 바리센트릭 가중치를 사용해서 점 p0~p2를 각 uv0~uv2에 맞는 색상 값을 구해서 점 그리기
 // 바리센트릭 가중치를 구하기 위해서 우선 세가지 정점으로 구성된 삼각형의
 // 내부와 그 정점마다 삼각형으로부터 얼마나 가까운지 각 uv에 어떤 가중치를 줄지 계산
-static void drawTexturedTriangle(const ssr::Vector3& p0, const ssr::Vector3& p1, const ssr::Vector3& p2,
-                                 const ssr::Vector2& uv0, const ssr::Vector2& uv1, const ssr::Vector2& uv2,
-                                 float invW0, float invW1, float invW2,
-                                 float clipZ0, float clipZ1, float clipZ2,
+// 깊이 테스트를 통과한 픽셀은 바로 그리지 않고 g_fragments에 모아서 SIMD로 셰이딩한다.
+static void drawTexturedTriangle(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2,
                                  const std::vector<uint32_t>& texture,
-                                 std::vector<float>& depthBuffer) {
-  ssr::Vector2 a{ p0.x, p0.y };
-  ssr::Vector2 b{ p1.x, p1.y };
-  ssr::Vector2 c{ p2.x, p2.y };
+                                 const ssr::Material& material,
+                                 ssr::FrameBuffer& target) {
+  ssr::Vector2 a{ v0.screen.x, v0.screen.y };
+  ssr::Vector2 b{ v1.screen.x, v1.screen.y };
+  ssr::Vector2 c{ v2.screen.x, v2.screen.y };
 
   float minX = std::min(a.x, std::min(b.x, c.x));
   float maxX = std::max(a.x, std::max(b.x, c.x));
@@ -243,64 +684,347 @@ static void drawTexturedTriangle(const ssr::Vector3& p0, const ssr::Vector3& p1,
   float maxY = std::max(a.y, std::max(b.y, c.y));
 
   int x0 = std::max(0, (int)std::floor(minX));
-  int x1 = std::min(SCREEN_WIDTH - 1, (int)std::ceil(maxX));
+  int x1 = std::min(g_screenWidth - 1, (int)std::ceil(maxX));
   int y0 = std::max(0, (int)std::floor(minY));
-  int y1 = std::min(SCREEN_HEIGHT - 1, (int)std::ceil(maxY));
+  int y1 = std::min(g_screenHeight - 1, (int)std::ceil(maxY));
 
   // 만약 이 삼각형의 영역이 0이라면 조기 리턴
   float area = edgeFunction(a, b, c.x, c.y);
   if (area == 0.0f) {
     return;
   }
-
-  // 삼각형을 그려야 하는 범위 (사각영역)
-  for (int y = y0; y <= y1; ++y) {
-    for (int x = x0; x <= x1; ++x) {
-      float px = x + 0.5f;
-      float py = y + 0.5f;
-
-      // 각 정점이 이루는 선분으로부터 해당 점에 대한 가중치값 계산
-      float w0 = edgeFunction(b, c, px, py);
-      float w1 = edgeFunction(c, a, px, py);
-      float w2 = edgeFunction(a, b, px, py);
-
-      // 삼각형의 모든 변에 대해 같은 방향으로 있어야 
-      // 내부로 판정됨
-      if ((area > 0.0f && (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)) ||
-          (area < 0.0f && (w0 > 0.0f || w1 > 0.0f || w2 > 0.0f))) {
-        continue;
-      }
-
-      float invArea = 1.0f / area;
-      w0 *= invArea;
-      w1 *= invArea;
-      w2 *= invArea;
-
-      float denom = (w0 * invW0) + (w1 * invW1) + (w2 * invW2);
-      if (denom == 0.0f) {
-        continue;
+  const float invArea = 1.0f / area;
+  const bool perPixel = material.frequency == ssr::ShadingFrequency::Pixel;
+  const bool linearizeTexels = ssr::srgb::enabled();
+  const bool opaque = material.blend == ssr::BlendMode::Opaque;
+
+  // 깊이 평면은 형식에 따라 원소 타입이 다르다. 비교는 float면 NDC 깊이 그대로, 정규화 정수면 양자화한 정수끼리
+  // (정수도 float에 담아 비교하므로 SIMD 경로는 형식과 무관하게 같다)
+  const ssr::DepthFormat depthFormat = target.depthFormat();
+  const ssr::DepthCompare depthCompare = g_depthCompare;
+  const bool floatDepth = ssr::depth::isFloat(depthFormat);
+  const bool unorm16 = depthFormat == ssr::DepthFormat::Unorm16;
+  const uint32_t unormMax = unorm16 ? ssr::depth::kUnorm16Max : ssr::depth::kUnorm24Max;
+  void* depthPlane = target.depthSamples();
+  float* depthFloat = static_cast<float*>(depthPlane);
+  uint16_t* depth16 = static_cast<uint16_t*>(depthPlane);
+  uint32_t* depth24 = static_cast<uint32_t*>(depthPlane);
+
+  // 정규화된 에지 함수(바리센트릭)는 화면 좌표에 선형이므로
+  // 픽셀 좌상단 값에 샘플 위치별 오프셋을 더해서 샘플마다 구한다
+  const ssr::msaa::SamplePattern& pattern = ssr::msaa::pattern(g_msaaSamples);
+  const int sampleCount = pattern.count;
+  const uint32_t allSamples = (1u << sampleCount) - 1;
+  float offset0[ssr::msaa::kMaxSamples], offset1[ssr::msaa::kMaxSamples], offset2[ssr::msaa::kMaxSamples];
+  for (int s = 0; s < sampleCount; ++s) {
+    const float ox = pattern.x[s];
+    const float oy = pattern.y[s];
+    offset0[s] = (ox * (c.y - b.y) - oy * (c.x - b.x)) * invArea;
+    offset1[s] = (ox * (a.y - c.y) - oy * (a.x - c.x)) * invArea;
+    offset2[s] = (ox * (b.y - a.y) - oy * (b.x - a.x)) * invArea;
+  }
+  const float center0 = (0.5f * (c.y - b.y) - 0.5f * (c.x - b.x)) * invArea;
+  const float center1 = (0.5f * (a.y - c.y) - 0.5f * (a.x - c.x)) * invArea;
+  const float center2 = (0.5f * (b.y - a.y) - 0.5f * (b.x - a.x)) * invArea;
+  // 4x는 샘플 4개를 Float4 한 번으로 판정한다
+  const bool simdSamples = sampleCount == 4;
+  const ssr::Float4 sampleOffset0 = ssr::Float4::load(offset0);
+  const ssr::Float4 sampleOffset1 = ssr::Float4::load(offset1);
+  const ssr::Float4 sampleOffset2 = ssr::Float4::load(offset2);
+  // 프레임버퍼 타일(8x8) 판정에 쓰는 여유. 에지 함수 기울기의 1/64 픽셀만큼 밖까지는 내부로 본다
+  // (모서리 값과 픽셀 값의 계산 순서가 달라 생기는 반올림 차이로 그릴 픽셀이 있는 타일을 빼먹지 않도록)
+  const float step0 = (std::fabs(c.y - b.y) + std::fabs(c.x - b.x)) * std::fabs(invArea);
+  const float step1 = (std::fabs(a.y - c.y) + std::fabs(a.x - c.x)) * std::fabs(invArea);
+  const float step2 = (std::fabs(b.y - a.y) + std::fabs(b.x - a.x)) * std::fabs(invArea);
+  const float margin0 = -step0 * (1.0f / 64.0f);
+  const float margin1 = -step1 * (1.0f / 64.0f);
+  const float margin2 = -step2 * (1.0f / 64.0f);
+  const int fbTileShift = ssr::FrameBuffer::kTileShift;
+  const int fbTileSize = ssr::FrameBuffer::kTileSize;
+
+  // HiZ는 "가까울수록 통과"하는 비교 함수에서만 쓴다 (Less / LessEqual, 뒤집은 형식은 Greater / GreaterEqual)
+  const bool reversedDepth = ssr::depth::isReversed(depthFormat);
+  const bool useHiZ = g_hiZEnabled &&
+                      (reversedDepth ? depthCompare == ssr::DepthCompare::Greater ||
+                                           depthCompare == ssr::DepthCompare::GreaterEqual
+                                     : depthCompare == ssr::DepthCompare::Less ||
+                                           depthCompare == ssr::DepthCompare::LessEqual);
+  const bool strictCompare = depthCompare == ssr::DepthCompare::Less || depthCompare == ssr::DepthCompare::Greater;
+  // nearest: 블록 안 삼각형 깊이의 가장 가까운 값 (NDC). 샘플 보간의 반올림 차이만큼 더 가깝게 잡고 비교 단위로 바꾼다
+  const auto hiZRejects = [&](float nearest, float farthestKey) {
+    const float z = reversedDepth ? nearest + kHiZSlack : nearest - kHiZSlack;
+    const float key = floatDepth ? z : (float)ssr::depth::quantize(z, unormMax);
+    if (reversedDepth) {
+      return strictCompare ? key <= farthestKey : key < farthestKey;
+    }
+    return strictCompare ? key >= farthestKey : key > farthestKey;
+  };
+  const float triangleNearest = reversedDepth ? std::max(v0.screen.z, std::max(v1.screen.z, v2.screen.z))
+                                              : std::min(v0.screen.z, std::min(v1.screen.z, v2.screen.z));
+
+  // 삼각형 전체: 바운딩 박스의 모든 블록에서 정점 깊이만으로 가려지면 타일 순회 없이 버린다
+  if (useHiZ) {
+    bool visible = false;
+    for (int blockY = y0 >> fbTileShift; blockY <= y1 >> fbTileShift && !visible; ++blockY) {
+      for (int blockX = x0 >> fbTileShift; blockX <= x1 >> fbTileShift; ++blockX) {
+        if (!hiZRejects(triangleNearest, target.hiZ(blockX, blockY))) {
+          visible = true;
+          break;
+        }
       }
-      float invDenom = 1.0f / denom;
-
-      float u = (uv0.x * invW0 * w0 + uv1.x * invW1 * w1 + uv2.x * invW2 * w2) * invDenom;
-      float v = (uv0.y * invW0 * w0 + uv1.y * invW1 * w1 + uv2.y * invW2 * w2) * invDenom;
-      float z = (clipZ0 * invW0 * w0 + clipZ1 * invW1 * w1 + clipZ2 * invW2 * w2) * invDenom;
+    }
+    if (!visible) {
+      ++g_hiZStats.culledTriangles;
+      return;
+    }
+  }
 
-      // 만약 z값이 깊이 버퍼에 있는 값보다 큰 경우 보이지 않음
-      int depthIndex = x + y * SCREEN_WIDTH;
-      if (z >= depthBuffer[depthIndex]) {
-        continue;
-      }
-      uint32_t color = sampleTexture(texture, u, v);
-      
-      // 알파값이 만약 0이라면 그리지 않고 건너뜀
-      if ((color >> 24) == 0) {
-        continue;
+  // 삼각형을 그려야 하는 범위 (사각영역)를 광원 타일 단위로 순회
+  // 한 타일 안의 픽셀은 같은 점광원 목록을 쓰므로 타일이 끝날 때마다 모아서 셰이딩
+  const int tileSize = ssr::TiledLightGrid::kTileSize;
+  for (int tileY = y0 / tileSize; tileY <= y1 / tileSize; ++tileY) {
+    for (int tileX = x0 / tileSize; tileX <= x1 / tileSize; ++tileX) {
+      const int tile = tileX + tileY * g_lightGrid.tilesX();
+      const int tx0 = std::max(x0, tileX * tileSize);
+      const int tx1 = std::min(x1, tileX * tileSize + tileSize - 1);
+      const int ty0 = std::max(y0, tileY * tileSize);
+      const int ty1 = std::min(y1, tileY * tileSize + tileSize - 1);
+
+      // 프레임버퍼 타일(8x8) 단위로 순회하면서 픽셀을 보기 전에 블록째 건너뛴다
+      // 1. 에지 함수는 선형이라 블록 샘플 영역의 네 모서리 중 최대값이 음수인 에지가 하나라도 있으면 샘플이 없다
+      // 2. HiZ: 블록 안 삼각형의 가장 가까운 깊이가 블록의 가장 먼 깊이보다 멀면 모든 샘플이 깊이 테스트에 실패
+      // 남은 블록만 지운 값으로 채우고 (지연 clear) 픽셀을 돈다
+      for (int blockY = ty0 >> fbTileShift; blockY <= ty1 >> fbTileShift; ++blockY) {
+        for (int blockX = tx0 >> fbTileShift; blockX <= tx1 >> fbTileShift; ++blockX) {
+          const int bx0 = std::max(tx0, blockX << fbTileShift);
+          const int bx1 = std::min(tx1, (blockX << fbTileShift) + fbTileSize - 1);
+          const int by0 = std::max(ty0, blockY << fbTileShift);
+          const int by1 = std::min(ty1, (blockY << fbTileShift) + fbTileSize - 1);
+          const float cornerX[4] = { (float)bx0, (float)(bx1 + 1), (float)bx0, (float)(bx1 + 1) };
+          const float cornerY[4] = { (float)by0, (float)by0, (float)(by1 + 1), (float)(by1 + 1) };
+          float corner0[4], corner1[4], corner2[4];
+          for (int k = 0; k < 4; ++k) {
+            corner0[k] = edgeFunction(b, c, cornerX[k], cornerY[k]) * invArea;
+            corner1[k] = edgeFunction(c, a, cornerX[k], cornerY[k]) * invArea;
+            corner2[k] = edgeFunction(a, b, cornerX[k], cornerY[k]) * invArea;
+          }
+          const auto max4 = [](const float* v) { return std::max(std::max(v[0], v[1]), std::max(v[2], v[3])); };
+          if (max4(corner0) < margin0 || max4(corner1) < margin1 || max4(corner2) < margin2) {
+            continue;
+          }
+          if (useHiZ) {
+            // 모서리의 평면 깊이는 삼각형 밖으로 외삽된 값일 수 있으므로 정점 깊이 범위와 함께 본다
+            float planeNearest = corner0[0] * v0.screen.z + corner1[0] * v1.screen.z + corner2[0] * v2.screen.z;
+            for (int k = 1; k < 4; ++k) {
+              const float z = corner0[k] * v0.screen.z + corner1[k] * v1.screen.z + corner2[k] * v2.screen.z;
+              planeNearest = reversedDepth ? std::max(planeNearest, z) : std::min(planeNearest, z);
+            }
+            const float nearest = reversedDepth ? std::min(planeNearest, triangleNearest)
+                                                : std::max(planeNearest, triangleNearest);
+            if (hiZRejects(nearest, target.hiZ(blockX, blockY))) {
+              ++g_hiZStats.culledBlocks;
+              continue;
+            }
+          }
+          ++g_hiZStats.drawnBlocks;
+          target.prepareTile(blockX, blockY);
+          bool wroteDepth = false;
+
+          for (int y = by0; y <= by1; ++y) {
+            for (int x = bx0; x <= bx1; ++x) {
+              // 각 정점이 이루는 선분으로부터 픽셀 좌상단에 대한 가중치값 계산
+              // invArea를 곱해두면 감기 방향과 무관하게 모든 가중치가 0 이상일 때 내부
+              const float e0 = edgeFunction(b, c, (float)x, (float)y) * invArea;
+              const float e1 = edgeFunction(c, a, (float)x, (float)y) * invArea;
+              const float e2 = edgeFunction(a, b, (float)x, (float)y) * invArea;
+
+              // 블렌딩 표면은 픽셀 중심으로만 내부 판정을 한다. 샘플 단위로 하면 메시 안쪽 공유 에지의 픽셀이
+              // 두 삼각형에 나뉘어 알파가 두 번 합성되면서 선이 보인다. 깊이 테스트는 샘플마다 해서
+              // 불투명 물체에 가려지는 경계는 그대로 안티에일리어싱된다.
+              const bool centerInside = e0 + center0 >= 0.0f && e1 + center1 >= 0.0f && e2 + center2 >= 0.0f;
+              if (!opaque && !centerInside) {
+                continue;
+              }
+
+              // 샘플마다 내부 판정과 깊이 테스트. NDC 깊이(z/w)는 화면 공간에서 선형이므로 원근 보정 없이 보간
+              const int depthIndex = x + y * g_screenWidth;
+              const size_t sampleIndex = target.sampleIndex(x, y);
+              // 통과하면 기록할 값 (float 형식은 NDC 깊이, 정규화 정수 형식은 양자화한 정수)
+              float passedDepth[ssr::msaa::kMaxSamples];
+              uint32_t inside = 0;
+              // 들어오는 깊이가 저장된 값보다 작은 / 큰 샘플. 비교 함수는 이 둘로 결정된다
+              uint32_t less = 0;
+              uint32_t greater = 0;
+              if (simdSamples) {
+                const ssr::Float4 s0 = ssr::Float4::splat(e0) + sampleOffset0;
+                const ssr::Float4 s1 = ssr::Float4::splat(e1) + sampleOffset1;
+                const ssr::Float4 s2 = ssr::Float4::splat(e2) + sampleOffset2;
+                inside = opaque ? ~ssr::bitMask(ssr::greaterThan(ssr::Float4::splat(0.0f), ssr::min(ssr::min(s0, s1), s2))) & allSamples
+                                : allSamples;
+                const ssr::Float4 sz = s0 * ssr::Float4::splat(v0.screen.z) + s1 * ssr::Float4::splat(v1.screen.z) +
+                                       s2 * ssr::Float4::splat(v2.screen.z);
+                ssr::Float4 incoming = sz;
+                ssr::Float4 stored;
+                if (floatDepth) {
+                  stored = ssr::Float4::load(depthFloat + sampleIndex);
+                } else {
+                  incoming = ssr::depth::quantize(sz, (float)unormMax);
+                  float storedKeys[4];
+                  for (int s = 0; s < 4; ++s) {
+                    storedKeys[s] = ssr::depth::readKey(depthFormat, depthPlane, sampleIndex + s);
+                  }
+                  stored = ssr::Float4::load(storedKeys);
+                }
+                incoming.store(passedDepth);
+                less = (uint32_t)ssr::bitMask(ssr::greaterThan(stored, incoming));
+                greater = (uint32_t)ssr::bitMask(ssr::greaterThan(incoming, stored));
+              } else {
+                for (int s = 0; s < sampleCount; ++s) {
+                  const float s0 = e0 + offset0[s];
+                  const float s1 = e1 + offset1[s];
+                  const float s2 = e2 + offset2[s];
+                  if (opaque && (s0 < 0.0f || s1 < 0.0f || s2 < 0.0f)) {
+                    continue;
+                  }
+                  inside |= 1u << s;
+                  const float sz = s0 * v0.screen.z + s1 * v1.screen.z + s2 * v2.screen.z;
+                  const float incoming = floatDepth ? sz : (float)ssr::depth::quantize(sz, unormMax);
+                  const float stored = floatDepth ? depthFloat[sampleIndex + s]
+                                                  : ssr::depth::readKey(depthFormat, depthPlane, sampleIndex + s);
+                  less |= (uint32_t)(incoming < stored) << s;
+                  greater |= (uint32_t)(incoming > stored) << s;
+                  passedDepth[s] = incoming;
+                }
+              }
+              const uint32_t coverage = inside & ssr::depth::passMask(depthCompare, less, greater, allSamples);
+              if (coverage == 0) {
+                continue;
+              }
+
+              // 셰이딩 위치: 모든 샘플이 안쪽이면 픽셀 중심, 에지 픽셀은 안쪽 샘플 하나 (centroid 근사)
+              // 삼각형 밖으로 외삽된 uv가 텍스처 경계를 넘어가지 않도록
+              float w0, w1, w2;
+              if (inside == allSamples) {
+                w0 = e0 + center0;
+                w1 = e1 + center1;
+                w2 = e2 + center2;
+              } else {
+                int firstInside = 0;
+                while ((inside & (1u << firstInside)) == 0) {
+                  ++firstInside;
+                }
+                w0 = e0 + offset0[firstInside];
+                w1 = e1 + offset1[firstInside];
+                w2 = e2 + offset2[firstInside];
+              }
+              const float z = w0 * v0.screen.z + w1 * v1.screen.z + w2 * v2.screen.z;
+
+              // 원근 보정된 바리센트릭 가중치
+              float b0 = w0 * v0.invW;
+              float b1 = w1 * v1.invW;
+              float b2 = w2 * v2.invW;
+              float denom = b0 + b1 + b2;
+              if (denom == 0.0f) {
+                continue;
+              }
+              float invDenom = 1.0f / denom;
+              b0 *= invDenom;
+              b1 *= invDenom;
+              b2 *= invDenom;
+
+              float u = v0.uv.x * b0 + v1.uv.x * b1 + v2.uv.x * b2;
+              float v = v0.uv.y * b0 + v1.uv.y * b1 + v2.uv.y * b2;
+
+              // 물 / 불은 텍스처 대신 노이즈 볼륨을 샘플링하는 표면 셰이더가 알베도를 만든다
+              ssr::SurfaceSample surface;
+              if (material.surface != ssr::SurfaceType::Textured) {
+                if (!ssr::surface::shade(material.surface, u, v, g_sceneTimeSeconds, surface)) {
+                  continue;
+                }
+              } else {
+                uint32_t color = sampleTexture(texture, u, v);
+
+                // 알파값이 만약 0이라면 그리지 않고 건너뜀
+                if ((color >> 24) == 0) {
+                  continue;
+                }
+                if (linearizeTexels) {
+                  // 텍셀은 sRGB로 저장되어 있으므로 라이팅 전에 선형으로
+                  surface.r = ssr::srgb::decode((uint8_t)(color >> 16));
+                  surface.g = ssr::srgb::decode((uint8_t)(color >> 8));
+                  surface.b = ssr::srgb::decode((uint8_t)color);
+                } else {
+                  surface.r = ((color >> 16) & 0xFF) * (1.0f / 255.0f);
+                  surface.g = ((color >> 8) & 0xFF) * (1.0f / 255.0f);
+                  surface.b = (color & 0xFF) * (1.0f / 255.0f);
+                }
+                surface.alpha = (color >> 24) * (1.0f / 255.0f);
+              }
+
+              // 깊이 버퍼 값 업데이트. 반투명 표면은 뒤에 그려지는 것을 가리지 않도록 기록하지 않음
+              if (opaque) {
+                wroteDepth = true;
+                for (int s = 0; s < sampleCount; ++s) {
+                  if ((coverage & (1u << s)) == 0) {
+                    continue;
+                  }
+                  if (floatDepth) {
+                    depthFloat[sampleIndex + s] = passedDepth[s];
+                  } else if (unorm16) {
+                    depth16[sampleIndex + s] = (uint16_t)passedDepth[s];
+                  } else {
+                    depth24[sampleIndex + s] = (uint32_t)passedDepth[s];
+                  }
+                }
+              } else if (coverage != allSamples) {
+                // 블렌딩 표면은 리졸브된 프레임버퍼에 합성하므로 가려지지 않은 샘플 비율을 알파에 곱한다
+                int covered = 0;
+                for (int s = 0; s < sampleCount; ++s) {
+                  covered += (coverage >> s) & 1;
+                }
+                surface.alpha *= (float)covered / sampleCount;
+              }
+
+              ssr::lighting::FragmentBatch& frag = g_fragments;
+              const int slot = frag.count++;
+              frag.pixel[slot] = (uint32_t)depthIndex;
+              frag.coverage[slot] = (uint8_t)coverage;
+              frag.sample[slot] = (uint32_t)sampleIndex;
+              frag.depth[slot] = z;
+              frag.albedoR[slot] = surface.r;
+              frag.albedoG[slot] = surface.g;
+              frag.albedoB[slot] = surface.b;
+              frag.alpha[slot] = (uint32_t)(surface.alpha * 255.0f + 0.5f);
+
+              if (perPixel) {
+                frag.posX[slot] = v0.world.x * b0 + v1.world.x * b1 + v2.world.x * b2;
+                frag.posY[slot] = v0.world.y * b0 + v1.world.y * b1 + v2.world.y * b2;
+                frag.posZ[slot] = v0.world.z * b0 + v1.world.z * b1 + v2.world.z * b2;
+                frag.normalX[slot] = v0.normal.x * b0 + v1.normal.x * b1 + v2.normal.x * b2 + surface.slopeX;
+                frag.normalY[slot] = v0.normal.y * b0 + v1.normal.y * b1 + v2.normal.y * b2;
+                frag.normalZ[slot] = v0.normal.z * b0 + v1.normal.z * b1 + v2.normal.z * b2 + surface.slopeZ;
+              } else {
+                frag.diffuseR[slot] = v0.diffuse.x * b0 + v1.diffuse.x * b1 + v2.diffuse.x * b2;
+                frag.diffuseG[slot] = v0.diffuse.y * b0 + v1.diffuse.y * b1 + v2.diffuse.y * b2;
+                frag.diffuseB[slot] = v0.diffuse.z * b0 + v1.diffuse.z * b1 + v2.diffuse.z * b2;
+                frag.specularR[slot] = v0.specular.x * b0 + v1.specular.x * b1 + v2.specular.x * b2;
+                frag.specularG[slot] = v0.specular.y * b0 + v1.specular.y * b1 + v2.specular.y * b2;
+                frag.specularB[slot] = v0.specular.z * b0 + v1.specular.z * b1 + v2.specular.z * b2;
+              }
+
+              if (frag.full()) {
+                flushFragments(material, tile);
+              }
+            }
+          }
+
+          if (useHiZ && wroteDepth) {
+            target.updateHiZ(blockX, blockY);
+          }
+        }
       }
 
-      // 깊이 버퍼 값 업데이트
-      depthBuffer[depthIndex] = z;
-      drawPoint(x, y, color);
+      flushFragments(material, tile);
     }
   }
 }
@@ -431,10 +1155,216 @@ SimpleMesh createCubeMesh() {
   return mesh;
 }
 
+// 큐브 아래에 깔리는 바닥 평면. 픽셀 라이팅 / 그림자가 잘 보이도록 격자로 나눈다
+SimpleMesh createGroundMesh() {
+  SimpleMesh mesh;
+  const int divisions = 8;
+  const float y = -1.2f;
+  const float minX = -4.0f, maxX = 4.0f;
+  const float minZ = -3.0f, maxZ = 5.0f;
+
+  for (int j = 0; j <= divisions; ++j) {
+    for (int i = 0; i <= divisions; ++i) {
+      const float u = (float)i / divisions;
+      const float v = (float)j / divisions;
+      mesh.vertices.push_back({ minX + (maxX - minX) * u, y, minZ + (maxZ - minZ) * v });
+      mesh.uvs.push_back({ u, v });
+      mesh.normals.push_back({ 0.0f, 1.0f, 0.0f });
+    }
+  }
+
+  // 큐브 윗면과 같은 감기 순서 (위에서 볼 때 시계 방향)
+  const uint32_t stride = divisions + 1;
+  for (int j = 0; j < divisions; ++j) {
+    for (int i = 0; i < divisions; ++i) {
+      const uint32_t i00 = i + j * stride;
+      const uint32_t i01 = i + (j + 1) * stride;
+      const uint32_t i11 = (i + 1) + (j + 1) * stride;
+      const uint32_t i10 = (i + 1) + j * stride;
+      mesh.indices.insert(mesh.indices.end(), { i00, i01, i11, i00, i11, i10 });
+    }
+  }
+
+  mesh.texture = createCheckerTexture();
+  mesh.material.model = ssr::ReflectionModel::Lambert;
+  mesh.castsShadows = false;
+  return mesh;
+}
+
+// 큐브 앞쪽 바닥 위에 얹는 물 평면. uv는 월드 크기에 비례 (노이즈는 wrap 샘플링)
+SimpleMesh createWaterMesh() {
+  SimpleMesh mesh;
+  const int divisions = 4;
+  const float y = -1.15f;
+  const float minX = -4.0f, maxX = 4.0f;
+  const float minZ = -3.0f, maxZ = -0.2f;
+
+  for (int j = 0; j <= divisions; ++j) {
+    for (int i = 0; i <= divisions; ++i) {
+      const float x = minX + (maxX - minX) * i / divisions;
+      const float z = minZ + (maxZ - minZ) * j / divisions;
+      mesh.vertices.push_back({ x, y, z });
+      mesh.uvs.push_back({ x * 0.25f, z * 0.25f });
+      mesh.normals.push_back({ 0.0f, 1.0f, 0.0f });
+    }
+  }
+
+  const uint32_t stride = divisions + 1;
+  for (int j = 0; j < divisions; ++j) {
+    for (int i = 0; i < divisions; ++i) {
+      const uint32_t i00 = i + j * stride;
+      const uint32_t i01 = i + (j + 1) * stride;
+      const uint32_t i11 = (i + 1) + (j + 1) * stride;
+      const uint32_t i10 = (i + 1) + j * stride;
+      mesh.indices.insert(mesh.indices.end(), { i00, i01, i11, i00, i11, i10 });
+    }
+  }
+
+  mesh.material.surface = ssr::SurfaceType::Water;
+  mesh.material.specular = { 0.9f, 0.9f, 0.9f };
+  mesh.material.shininess = 96.0f;
+  mesh.material.blend = ssr::BlendMode::Alpha;
+  mesh.castsShadows = false;
+  return mesh;
+}
+
+// 큐브 왼쪽 뒤에 세운 불꽃 사각형. v = 0 위쪽, v = 1 바닥
+SimpleMesh createFireMesh() {
+  SimpleMesh mesh;
+  const float minX = -2.7f, maxX = -1.7f;
+  const float minY = -1.2f, maxY = 0.4f;
+  const float z = 1.5f;
+
+  mesh.vertices = {
+    { minX, minY, z }, { minX, maxY, z }, { maxX, maxY, z }, { maxX, minY, z },
+  };
+  mesh.uvs = {
+    { 0.0f, 1.0f }, { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f },
+  };
+  mesh.normals.assign(4, { 0.0f, 0.0f, -1.0f });
+  mesh.indices = { 0, 1, 2, 0, 2, 3 };
+
+  mesh.material.surface = ssr::SurfaceType::Fire;
+  mesh.material.emissive = true;
+  mesh.material.blend = ssr::BlendMode::Additive;
+  mesh.castsShadows = false;
+  return mesh;
+}
+
 void initMesh() {
   //g_mesh = createTetrahedronMesh();
   g_mesh = createCubeMesh();
+  if (g_mesh.normals.size() != g_mesh.vertices.size()) {
+    ssr::lighting::generateVertexNormals(g_mesh.vertices, g_mesh.indices, g_mesh.normals);
+  }
+  g_groundMesh = createGroundMesh();
+  g_waterMesh = createWaterMesh();
+  g_fireMesh = createFireMesh();
+  ssr::surface::initNoise();
   g_transformedVerts.resize(g_mesh.vertices.size());
+  g_shadowMap.resize(kShadowMapSize);
+  g_oit.resize(g_screenWidth, g_screenHeight);
+  g_oit.setDepthRange(Z_NEAR, Z_FAR, ssr::depth::isReversed(g_depthFormat));
+  g_taa.resize(g_screenWidth, g_screenHeight);
+}
+
+// 야간 씬 점광원: 큐브를 감싸는 구 위에 골든 스파이럴로 배치하고 Y축으로 공전
+const int kNightLightCount = 256;
+const float kNightLightOrbitRadius = 1.5f;
+const float kNightLightOrbitSpeedDegPerSec = 40.0f;
+std::vector<ssr::PointLight> g_nightLightsBase;
+float g_nightLightOrbitDeg = 0.0f;
+
+void initNightLights() {
+  const float goldenAngle = 2.39996323f;
+  g_nightLightsBase.resize(kNightLightCount);
+  for (int i = 0; i < kNightLightCount; ++i) {
+    const float y = 1.0f - 2.0f * (i + 0.5f) / kNightLightCount;
+    const float ring = std::sqrt(1.0f - y * y);
+    const float theta = goldenAngle * i;
+
+    ssr::PointLight& light = g_nightLightsBase[i];
+    light.position = ssr::Vector3{ std::cos(theta) * ring, y, std::sin(theta) * ring } * kNightLightOrbitRadius;
+    light.color = { 0.5f + 0.5f * std::cos(theta),
+                    0.5f + 0.5f * std::cos(theta + 2.094f),
+                    0.5f + 0.5f * std::cos(theta + 4.189f) };
+    light.intensity = 0.6f;
+    light.range = 0.6f;
+  }
+}
+
+void updateNightLights(float deltaSeconds) {
+  g_nightLightOrbitDeg += kNightLightOrbitSpeedDegPerSec * deltaSeconds;
+  if (g_nightLightOrbitDeg >= 360.0f) {
+    g_nightLightOrbitDeg -= 360.0f;
+  }
+
+  ssr::Matrix4x4 orbit = ssr::Matrix4x4::identity;
+  orbit.rotateY(g_nightLightOrbitDeg);
+  for (size_t i = 0; i < g_nightLightsBase.size(); ++i) {
+    g_lights.points[i].position = orbit * g_nightLightsBase[i].position;
+  }
+}
+
+void initPostProcess() {
+  g_colorGrading.contrast = 1.05f;
+  g_colorGrading.saturation = 1.1f;
+  g_colorGrading.gain = { 1.03f, 1.0f, 0.96f };
+
+  // TAA는 지터된 샘플을 모으는 단계라 맨 앞. 재투영에는 지터 없는 행렬을 넘긴다
+  g_postProcess.addFramePass("taa", [](uint32_t* pixels, int, int, int pitchInPixels, ssr::ThreadPool& pool) {
+    g_taa.resolve(pixels, pitchInPixels, g_frameBuffer, g_cameraMat * g_projectionMat, pool);
+  }, &g_taaEnabled);
+  // 블룸은 톤 매핑 전 밝기로 추출
+  g_postProcess.addFramePass("bloom", [](uint32_t* pixels, int width, int height, int pitchInPixels,
+                                         ssr::ThreadPool& pool) {
+    g_bloom.apply(pixels, width, height, pitchInPixels, pool);
+  }, &g_bloomEnabled);
+  g_postProcess.addPixelPass("tonemap", [](const ssr::PixelRow& row) { g_toneMapping.process(row); },
+                             &g_gradingEnabled);
+  g_postProcess.addPixelPass("grade", [](const ssr::PixelRow& row) { g_colorGrading.process(row); },
+                             &g_gradingEnabled);
+  g_postProcess.addPixelPass("vignette", [](const ssr::PixelRow& row) { g_vignette.process(row); },
+                             &g_gradingEnabled);
+  // FXAA는 최종 휘도를 보고 에지를 찾으므로 색 보정 뒤
+  g_postProcess.addFramePass("fxaa", [](uint32_t* pixels, int width, int height, int pitchInPixels,
+                                        ssr::ThreadPool& pool) {
+    g_fxaa.apply(pixels, width, height, pitchInPixels, pool);
+  }, &g_fxaaEnabled);
+}
+
+void initLights() {
+  if (g_nightScene) {
+    if (g_nightLightsBase.empty()) {
+      initNightLights();
+    }
+    g_lights.ambient = { 0.02f, 0.02f, 0.04f };
+
+    ssr::DirectionalLight moon;
+    moon.direction = { 0.3f, -0.8f, 0.5f };
+    moon.color = { 0.6f, 0.7f, 1.0f };
+    moon.intensity = 0.15f;
+    moon.shadowMap = g_shadowsEnabled ? &g_shadowMap : nullptr;
+    g_lights.directionals = { moon };
+    g_lights.points = g_nightLightsBase;
+    return;
+  }
+
+  g_lights.ambient = { 0.08f, 0.08f, 0.1f };
+
+  ssr::DirectionalLight sun;
+  sun.direction = { -0.4f, -0.7f, 0.6f };
+  sun.color = { 1.0f, 0.96f, 0.9f };
+  sun.intensity = 0.9f;
+  sun.shadowMap = g_shadowsEnabled ? &g_shadowMap : nullptr;
+  g_lights.directionals = { sun };
+
+  ssr::PointLight fill;
+  fill.position = { 2.0f, 1.5f, -2.5f };
+  fill.color = { 0.4f, 0.6f, 1.0f };
+  fill.intensity = 1.2f;
+  fill.range = 6.0f;
+  g_lights.points = { fill };
 }
 
 // #1 Bresenham's line algorithm
@@ -502,49 +1432,48 @@ void drawLineWithBresenhamAlgorithm(const ssr::Vector2& startPos, const ssr::Vec
   }
 }
 
-// 주어진 세 개의 3D 정점으로 이루어진 삼각형을 그리기
-void renderMeshTextured(double deltaMs) {
-  if (g_mesh.vertices.empty() || g_mesh.indices.empty()) {
-    g_logThisFrame = false;
+// 메시 하나를 변환 / 라이팅 / 래스터라이즈
+// 광원 타일 목록(g_lightGrid)과 그림자 맵은 renderScene에서 미리 준비되어 있어야 한다.
+void renderMeshTextured(const SimpleMesh& mesh) {
+  if (mesh.vertices.empty() || mesh.indices.empty()) {
     return;
   }
-
-  if (g_transformedVerts.size() != g_mesh.vertices.size()) {
-    g_transformedVerts.resize(g_mesh.vertices.size());
-  }
-  if (g_invWs.size() != g_mesh.vertices.size()) {
-    g_invWs.resize(g_mesh.vertices.size());
-  }
-  if (g_clipZs.size() != g_mesh.vertices.size()) {
-    g_clipZs.resize(g_mesh.vertices.size());
-  }
-  if (g_mesh.uvs.size() != g_mesh.vertices.size()) {
-    g_logThisFrame = false;
+  if (mesh.uvs.size() != mesh.vertices.size() ||
+      mesh.normals.size() != mesh.vertices.size()) {
     return;
   }
 
-  const float deltaSeconds = static_cast<float>(deltaMs) * 0.001f;
-  if (deltaSeconds > 0.0f) {
-    g_meshRotationDeg += g_meshRotationSpeedDegPerSec * deltaSeconds;
-    if (g_meshRotationDeg >= 360.0f) {
-      g_meshRotationDeg -= 360.0f;
-    }
+  if (g_transformedVerts.size() != mesh.vertices.size()) {
+    g_transformedVerts.resize(mesh.vertices.size());
+  }
+  if (g_invWs.size() != mesh.vertices.size()) {
+    g_invWs.resize(mesh.vertices.size());
+  }
+  if (g_worldPositions.size() != mesh.vertices.size()) {
+    g_worldPositions.resize(mesh.vertices.size());
+    g_worldNormals.resize(mesh.vertices.size());
+    g_vertexDiffuse.resize(mesh.vertices.size());
+    g_vertexSpecular.resize(mesh.vertices.size());
   }
 
-  ssr::Matrix4x4 modelMat = ssr::Matrix4x4::identity;
-  modelMat.rotateY(g_meshRotationDeg);
+  const ssr::Matrix4x4& modelMat = mesh.modelMat;
 
-  for (size_t i = 0; i < g_mesh.vertices.size(); ++i) {
-    ssr::Vector4 v = { g_mesh.vertices[i].x, g_mesh.vertices[i].y, g_mesh.vertices[i].z, 1.0f };
+  for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+    ssr::Vector4 v = { mesh.vertices[i].x, mesh.vertices[i].y, mesh.vertices[i].z, 1.0f };
     v = modelMat * v;
+    g_worldPositions[i] = { v.x, v.y, v.z };
+
+    // 모델 행렬에 회전만 있으므로 역전치 행렬 없이 w = 0 으로 노멀을 그대로 변환
+    ssr::Vector4 n = { mesh.normals[i].x, mesh.normals[i].y, mesh.normals[i].z, 0.0f };
+    n = modelMat * n;
+    g_worldNormals[i] = { n.x, n.y, n.z };
 
     // 클립 공간을 적용하는 행렬을 가져와서 
     // 텍스처 적용 시 "원근 보정" 적용할 값을 가져옴
-    ssr::Vector4 clip = (g_projectionMat * (g_cameraMat * v));
+    ssr::Vector4 clip = (g_renderProjectionMat * (g_cameraMat * v));
 
     float invW = (clip.w != 0.0f) ? (1.0f / clip.w) : 0.0f;
     g_invWs[i] = invW;
-    g_clipZs[i] = clip.z;
 
     ssr::Vector4 ndc = { clip.x * invW, clip.y * invW, clip.z * invW, 1.0f };
     ndc = g_viewportMat * ndc;
@@ -558,70 +1487,523 @@ void renderMeshTextured(double deltaMs) {
     }
   }
 
-  for (size_t idx = 0; idx + 2 < g_mesh.indices.size(); idx += 3) {
-    uint32_t i0 = g_mesh.indices[idx];
-    uint32_t i1 = g_mesh.indices[idx + 1];
-    uint32_t i2 = g_mesh.indices[idx + 2];
-    const ssr::Vector3& v0 = g_transformedVerts[i0];
-    const ssr::Vector3& v1 = g_transformedVerts[i1];
-    const ssr::Vector3& v2 = g_transformedVerts[i2];
-    const ssr::Vector2& uv0 = g_mesh.uvs[i0];
-    const ssr::Vector2& uv1 = g_mesh.uvs[i1];
-    const ssr::Vector2& uv2 = g_mesh.uvs[i2];
-    float invW0 = g_invWs[i0];
-    float invW1 = g_invWs[i1];
-    float invW2 = g_invWs[i2];
-    float clipZ0 = g_clipZs[i0];
-    float clipZ1 = g_clipZs[i1];
-    float clipZ2 = g_clipZs[i2];
+  // 정점 / 면 단위 라이팅은 래스터라이즈 전에 배치로 한 번에 계산
+  const ssr::Material& material = mesh.material;
+  const size_t triangleCount = mesh.indices.size() / 3;
+  if (material.frequency == ssr::ShadingFrequency::Vertex) {
+    ssr::lighting::shadeVertices(g_lights, material, g_camera.m_eye,
+                                 g_worldPositions.data(), g_worldNormals.data(), g_worldPositions.size(),
+                                 g_vertexDiffuse.data(), g_vertexSpecular.data());
+  } else if (material.frequency == ssr::ShadingFrequency::Flat) {
+    g_faceCentroids.resize(triangleCount);
+    g_faceNormals.resize(triangleCount);
+    g_faceDiffuse.resize(triangleCount);
+    g_faceSpecular.resize(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+      const ssr::Vector3& p0 = g_worldPositions[mesh.indices[t * 3]];
+      const ssr::Vector3& p1 = g_worldPositions[mesh.indices[t * 3 + 1]];
+      const ssr::Vector3& p2 = g_worldPositions[mesh.indices[t * 3 + 2]];
+      g_faceCentroids[t] = (p0 + p1 + p2) * (1.0f / 3.0f);
+      g_faceNormals[t] = ssr::math::crossProduct(p1 - p0, p2 - p0);
+    }
+    ssr::lighting::shadeVertices(g_lights, material, g_camera.m_eye,
+                                 g_faceCentroids.data(), g_faceNormals.data(), triangleCount,
+                                 g_faceDiffuse.data(), g_faceSpecular.data());
+  }
+
+  for (size_t idx = 0; idx + 2 < mesh.indices.size(); idx += 3) {
+    const uint32_t indices[3] = { mesh.indices[idx], mesh.indices[idx + 1], mesh.indices[idx + 2] };
+
+    RasterVertex rv[3];
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t i = indices[k];
+      rv[k].screen = g_transformedVerts[i];
+      rv[k].invW = g_invWs[i];
+      rv[k].uv = mesh.uvs[i];
+      rv[k].world = g_worldPositions[i];
+      rv[k].normal = g_worldNormals[i];
+      if (material.frequency == ssr::ShadingFrequency::Vertex) {
+        rv[k].diffuse = g_vertexDiffuse[i];
+        rv[k].specular = g_vertexSpecular[i];
+      } else if (material.frequency == ssr::ShadingFrequency::Flat) {
+        rv[k].diffuse = g_faceDiffuse[idx / 3];
+        rv[k].specular = g_faceSpecular[idx / 3];
+      }
+    }
 
-    drawTexturedTriangle(v0, v1, v2, uv0, uv1, uv2,
-                         invW0, invW1, invW2,
-                         clipZ0, clipZ1, clipZ2,
-                         g_mesh.texture, g_depthBuffer);
+    drawTexturedTriangle(rv[0], rv[1], rv[2], mesh.texture, material, g_frameBuffer);
   }
 
+}
+
+
+std::vector<ssr::Vector3> g_shadowCasterPositions;
+
+// 그림자를 드리우는 메시만 광원 시점에서 깊이 전용으로 그림
+void renderShadowMap(const ssr::DirectionalLight& light) {
+  g_shadowMap.setupDirectional(light.direction, kShadowCenter, kShadowRadius);
+  g_shadowMap.clear();
+
+  const SimpleMesh* meshes[] = { &g_mesh, &g_groundMesh };
+  for (const SimpleMesh* mesh : meshes) {
+    if (!mesh->castsShadows || mesh->indices.empty()) {
+      continue;
+    }
+    g_shadowCasterPositions.resize(mesh->vertices.size());
+    for (size_t i = 0; i < mesh->vertices.size(); ++i) {
+      g_shadowCasterPositions[i] = mesh->modelMat * mesh->vertices[i];
+    }
+    g_shadowMap.renderDepth(g_shadowCasterPositions.data(), g_shadowCasterPositions.size(),
+                            mesh->indices.data(), mesh->indices.size());
+  }
+}
+
+void renderScene(double deltaMs) {
+  const float deltaSeconds = static_cast<float>(deltaMs) * 0.001f;
+  g_hiZStats = HiZStats();
+  if (deltaSeconds > 0.0f) {
+    g_sceneTimeSeconds += deltaSeconds;
+    g_meshRotationDeg += g_meshRotationSpeedDegPerSec * deltaSeconds;
+    if (g_meshRotationDeg >= 360.0f) {
+      g_meshRotationDeg -= 360.0f;
+    }
+  }
+
+  g_mesh.modelMat = ssr::Matrix4x4::identity;
+  g_mesh.modelMat.rotateY(g_meshRotationDeg);
+
+  g_renderProjectionMat = g_projectionMat;
+  if (g_taaEnabled) {
+    ssr::TemporalAA::applyJitter(g_renderProjectionMat, g_taa.nextJitter(), g_screenWidth, g_screenHeight);
+  }
+
+  // 점광원을 화면 타일에 배정. 픽셀 셰이딩은 자기 타일 목록만 순회한다.
+  if (g_nightScene) {
+    updateNightLights(deltaSeconds);
+  }
+  g_lightGrid.build(g_lights.points, g_cameraMat, g_renderProjectionMat, g_viewportMat,
+                    g_screenWidth, g_screenHeight, Z_NEAR);
+  if (g_logThisFrame) {
+    printf("light grid: %zu point lights, %zu tile entries (%dx%d tiles)\n",
+           g_lights.points.size(), g_lightGrid.totalEntries(), g_lightGrid.tilesX(), g_lightGrid.tilesY());
+  }
+
+  // 그림자 맵은 하나만 두고 그것을 참조하는 방향광 기준으로 갱신
+  for (const ssr::DirectionalLight& light : g_lights.directionals) {
+    if (light.shadowMap == &g_shadowMap) {
+      renderShadowMap(light);
+      break;
+    }
+  }
+
+  // 1. 불투명: 깊이를 기록하므로 반투명보다 먼저. 샘플 버퍼에 그린 뒤 리졸브
+  renderMeshTextured(g_groundMesh);
+  renderMeshTextured(g_mesh);
+  g_frameBuffer.resolve(ssr::srgb::enabled());
+  // 2. 알파 블렌딩: 그리는 순서와 무관하게 OIT 버퍼에 누적한 뒤 합성
+  renderMeshTextured(g_waterMesh);
+  g_oit.composite(g_frameBuffer.output(), g_frameBuffer.outputPitch());
+  // 3. 가산 / 곱셈 블렌딩: 순서 무관이므로 프레임버퍼에 바로
+  renderMeshTextured(g_fireMesh);
+
+  if (g_logThisFrame) {
+    printf("frame buffer: %d / %d tiles touched\n", g_frameBuffer.preparedTileCount(),
+           g_frameBuffer.tilesX() * g_frameBuffer.tilesY());
+    printf("hiz %s: %d triangles culled, %d blocks culled, %d blocks drawn\n", g_hiZEnabled ? "on" : "off",
+           g_hiZStats.culledTriangles, g_hiZStats.culledBlocks, g_hiZStats.drawnBlocks);
+  }
   g_logThisFrame = false;
 }
 
+// 창 크기가 바뀌었을 때 (SDL_WINDOWEVENT_SIZE_CHANGED). 화면 크기에 묶인 버퍼와 행렬을 새 크기로 맞춘다
+// 프레임버퍼(샘플 / 깊이 / Hi-Z / 출력 평면)는 다음 beginFrame이 다시 할당한다. 장면 상태를 만지는 스레드에서 호출
+void resizeScreen(int width, int height) {
+  if (width <= 0 || height <= 0 || (width == g_screenWidth && height == g_screenHeight)) {
+    return;
+  }
+  g_screenWidth = width;
+  g_screenHeight = height;
+  g_oit.resize(width, height);
+  // 이전 크기의 히스토리는 버린다 (다음 프레임부터 다시 쌓음)
+  g_taa.resize(width, height);
+  g_camera.m_aspect = (float)width / height;
+  initMatrices((float)width, (float)height);
+  printf("resize: %dx%d\n", width, height);
+  if (g_exporter.isRunning() && (g_exporter.width() != width || g_exporter.height() != height)) {
+    printf("export: skipping frames until the window is back to %dx%d\n", g_exporter.width(), g_exporter.height());
+  }
+}
+
+// 출력 평면은 리졸브가 전부 덮어쓰므로 샘플 평면만 비운다. MSAA / 깊이 형식 전환 시에만 다시 할당
+// clear는 타일 플래그만 세우고, 샘플은 삼각형이 처음 걸칠 때 채워진다
+void beginFrame() {
+  g_frameBuffer.resize(g_screenWidth, g_screenHeight, g_msaaSamples, g_frameBufferLayout, g_depthFormat);
+  g_frameBuffer.clear(0u, ssr::depth::farValue(g_depthFormat));
+}
+
+// 이번 프레임을 내보낼지. 창 크기가 내보내기 크기와 다른 동안은 건너뛴다
+bool exportThisFrame() {
+  return g_exporter.isRunning() && g_exporter.width() == g_screenWidth && g_exporter.height() == g_screenHeight;
+}
+
+// 장면 + 후처리 (TAA / 색 보정 / FXAA. 켜진 패스만, 이웃한 픽셀 패스는 한 번에)
+// 결과는 g_presentTarget이 있으면 거기(마지막 훑기가 바로 씀), 없으면 g_frameBuffer.output()
+// swapRedBlue면 결과를 R / B 바꿔서 쓴다. 내보내기가 켜져 있으면 바꾸기 전의 완성된 프레임을 넘긴다
+void drawFrame(double deltaMs, bool swapRedBlue) {
+  renderScene(deltaMs);
+  if (!exportThisFrame()) {
+    g_postProcess.run(g_frameBuffer.output(), g_screenWidth, g_screenHeight, g_frameBuffer.outputPitch(),
+                      *g_threadPool, g_presentTarget, g_presentTargetPitch, swapRedBlue);
+    return;
+  }
+  g_postProcess.run(g_frameBuffer.output(), g_screenWidth, g_screenHeight, g_frameBuffer.outputPitch(),
+                    *g_threadPool);
+  // 복사만 하고 돌아온다. 인코드는 내보내기 스레드에서
+  g_exporter.submit(g_frameBuffer.output(), g_frameBuffer.outputPitch());
+  if (g_presentTarget != nullptr) {
+    ssr::post::copyFrame(g_frameBuffer.output(), g_frameBuffer.outputPitch(), g_presentTarget, g_presentTargetPitch,
+                         g_screenWidth, g_screenHeight, swapRedBlue, *g_threadPool);
+  } else if (swapRedBlue) {
+    ssr::post::swapRedBlue(g_frameBuffer.output(), g_screenWidth, g_screenHeight, g_frameBuffer.outputPitch(),
+                           *g_threadPool);
+  }
+}
+
+// 렌더 스레드: 메인 스레드가 넘긴 키 입력을 반영하고, 트리플 버퍼의 빈 프레임에 그려서 넘긴다
+// 장면 상태(카메라, 조명, 후처리 설정)는 이 스레드만 만진다
+void renderThreadLoop() {
+  constexpr int kStopPollIntervalMs = 4;
+  // 목표 fps나 vsync가 있으면 출력 스레드가 넘긴 프레임을 가져간 뒤에 다음 프레임을 그린다.
+  // 안 그러면 마감 사이에 그린 프레임이 대부분 덮여 버려진다. 그리는 동안 출력은 앞 프레임을 올리므로 겹침은 그대로
+  const bool paced = g_framePacer.mode() != ssr::FramePacer::Mode::Unlimited;
+  std::vector<SDL_Event> events;
+  uint64_t frameIndex = 0;
+  g_program->updateTime();
+  while (g_renderThreadStop.load(std::memory_order_acquire) == false) {
+    if (paced && frameIndex > 0 &&
+        !g_presentFrames.waitForConsumed(std::chrono::milliseconds(kStopPollIntervalMs))) {
+      continue;
+    }
+    g_program->updateTime();
+    {
+      std::lock_guard<std::mutex> lock(g_pendingEventsMutex);
+      events.swap(g_pendingEvents);
+    }
+    for (const SDL_Event& event : events) {
+      if (event.type == SDL_WINDOWEVENT) {
+        resizeScreen(event.window.data1, event.window.data2);
+      } else {
+        handleKeyInput(event);
+      }
+    }
+    events.clear();
+
+    ssr::TripleBuffer::Frame& frame = g_presentFrames.writeFrame();
+    frame.resize(g_screenWidth, g_screenHeight);
+    frame.index = ++frameIndex;
+    beginFrame();
+    g_frameBuffer.bindOutput(frame.pixels.data(), frame.width);
+    // R / B 교환은 출력 스레드가 텍스처로 옮기면서 (uploadFrame)
+    drawFrame(g_program->delta(), false);
+    g_frameBuffer.bindOutput(nullptr, 0);
+    g_presentFrames.publish();
+  }
+}
+
+// 화면 텍스처를 width x height로 맞춘다. 크기가 다를 때만 다시 만든다 (창 표면 출력은 텍스처가 없음)
+bool ensureScreenTexture(ssr::SDLRenderer& renderer, int width, int height) {
+  if (g_presentMode == PresentMode::Surface ||
+      (g_screenTexture != nullptr && g_screenTextureWidth == width && g_screenTextureHeight == height)) {
+    return true;
+  }
+  if (g_screenTexture != nullptr) {
+    SDL_DestroyTexture(g_screenTexture);
+  }
+  g_screenTexture = SDL_CreateTexture(renderer.native(), g_screenTextureFormat, SDL_TEXTUREACCESS_STREAMING,
+                                      width, height);
+  g_screenTextureWidth = g_screenTexture != nullptr ? width : 0;
+  g_screenTextureHeight = g_screenTexture != nullptr ? height : 0;
+  return g_screenTexture != nullptr;
+}
+
+// 완성된 프레임 한 장을 화면 텍스처 / 창 표면으로 옮긴다 (출력 스레드)
+void uploadFrame(ssr::SDLRenderer& renderer, const ssr::TripleBuffer::Frame& frame) {
+  const uint32_t* pixels = frame.pixels.data();
+  if (g_presentMode == PresentMode::Surface) {
+    SDL_Surface* surface = renderer.windowSurface();
+    if (surface == nullptr || (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0)) {
+      return;
+    }
+    SDL_ConvertPixels(std::min(surface->w, frame.width), std::min(surface->h, frame.height),
+                      SDL_PIXELFORMAT_ARGB8888, pixels, frame.width * 4,
+                      surface->format->format, surface->pixels, surface->pitch);
+    if (SDL_MUSTLOCK(surface)) {
+      SDL_UnlockSurface(surface);
+    }
+    return;
+  }
+
+  // 창 크기가 바뀐 직후에는 이전 크기 프레임과 새 크기 프레임이 섞여 온다. 텍스처는 프레임 크기를 따른다
+  if (!ensureScreenTexture(renderer, frame.width, frame.height)) {
+    return;
+  }
+  // 완성된 프레임을 옮기기만 하므로 잠가서 복사해도 줄어드는 복사가 없다.
+  // R / B를 바꿔야 할 때만 잠근 텍스처에 바꿔 쓰면서 옮긴다 (스레드 풀은 렌더 스레드 것이라 한 스레드로)
+  void* texturePixels = nullptr;
+  int texturePitch = 0;
+  if (g_swapRedBlue && SDL_LockTexture(g_screenTexture, nullptr, &texturePixels, &texturePitch) == 0) {
+    for (int y = 0; y < frame.height; ++y) {
+      ssr::post::copyRow(pixels + (size_t)y * frame.width,
+                         reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(texturePixels) + (size_t)y * texturePitch),
+                         frame.width, true);
+    }
+    SDL_UnlockTexture(g_screenTexture);
+  } else {
+    SDL_UpdateTexture(g_screenTexture, nullptr, pixels, frame.width * 4);
+  }
+  SDL_RenderCopy(renderer.native(), g_screenTexture, nullptr, nullptr);
+}
+
+// 메인 스레드는 이벤트를 받고 완성된 프레임을 올려서 내보내기만 한다
+// 업로드와 vsync 대기가 렌더 스레드의 다음 프레임과 겹친다. SDL 호출은 모두 이 스레드에서
+int runPipelined(ssr::SDLRenderer& renderer) {
+  constexpr int kEventPollIntervalMs = 4;
+  g_renderThreadStop.store(false, std::memory_order_relaxed);
+  std::thread renderThread(renderThreadLoop);
+
+  uint64_t presented = 0;
+  uint64_t lastIndex = 0;
+  uint64_t skipped = 0;
+  bool quit = false;
+  while (quit == false) {
+    SDL_Event event;
+    while (quit == false && SDL_PollEvent(&event) != 0) {
+      if (event.type == SDL_QUIT) {
+        quit = true;
+      } else if (event.type == SDL_KEYDOWN ||
+                 (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)) {
+        // 화면 크기는 렌더 스레드가 바꾼다. 텍스처는 uploadFrame이 프레임 크기에 맞춘다
+        if (event.type == SDL_WINDOWEVENT) {
+          g_program->resize(event.window.data1, event.window.data2);
+        }
+        std::lock_guard<std::mutex> lock(g_pendingEventsMutex);
+        g_pendingEvents.push_back(event);
+      }
+    }
+    bool presentedNow = false;
+    if (quit == false && g_presentFrames.acquire()) {
+      const ssr::TripleBuffer::Frame& frame = g_presentFrames.readFrame();
+      // 출력이 느려서 덮어쓴 프레임 수
+      skipped += frame.index - lastIndex - 1;
+      lastIndex = frame.index;
+      ++presented;
+      uploadFrame(renderer, frame);
+      renderer.present();
+      presentedNow = true;
+    }
+    // 목표 fps가 있으면 새 프레임이 없어도 다음 마감까지 (그때 가장 최근 프레임을 내보냄)
+    // 그 밖에는 새 프레임이 없을 때만 렌더 스레드의 publish를 기다린다. 프레임이 오면 바로 깨고,
+    // 렌더가 느려도 kEventPollIntervalMs마다는 이벤트를 받는다
+    if (g_framePacer.mode() == ssr::FramePacer::Mode::Fixed || presentedNow) {
+      reportFramePacing(g_framePacer.wait());
+    } else {
+      g_presentFrames.waitForFresh(std::chrono::milliseconds(kEventPollIntervalMs));
+    }
+  }
+
+  g_renderThreadStop.store(true, std::memory_order_release);
+  renderThread.join();
+  printf("pipeline: %llu frames presented, %llu overwritten before present\n",
+         (unsigned long long)presented, (unsigned long long)skipped);
+  logFramePacingSummary();
+  g_exporter.finish();
+  g_program->quit();
+  return 0;
+}
+
+// 화면 크기의 프레임을 path로 내보내기 시작한다 (g_exporter). 형식은 SSR_EXPORT_FORMAT, 없으면 확장자
+// (모르는 확장자는 PPM, "-"(표준 출력)는 Y4M). SSR_EXPORT_QUEUE=떠 있을 수 있는 프레임 수, SSR_EXPORT_THREADS=인코더 스레드 수
+bool startExporter(const char* path, bool numbered) {
+  ssr::FrameExporter::Settings settings;
+  settings.path = path;
+  settings.numbered = numbered;
+  settings.width = g_screenWidth;
+  settings.height = g_screenHeight;
+  const char* formatEnv = std::getenv("SSR_EXPORT_FORMAT");
+  if (formatEnv != nullptr) {
+    if (!ssr::FrameExporter::parseFormat(formatEnv, settings.format)) {
+      printf("SSR_EXPORT_FORMAT: unknown format '%s' (png / ppm / y4m / raw)\n", formatEnv);
+      return false;
+    }
+  } else if (!ssr::FrameExporter::formatFromPath(settings.path, settings.format)) {
+    settings.format = settings.path == "-" ? ssr::FrameExporter::Format::Y4m : ssr::FrameExporter::Format::Ppm;
+  }
+  settings.fps = g_framePacer.targetFps() > 0.0 ? (int)(g_framePacer.targetFps() + 0.5) : 60;
+  if (const char* queue = std::getenv("SSR_EXPORT_QUEUE")) {
+    settings.queueDepth = std::max(1, std::atoi(queue));
+  }
+  if (const char* threads = std::getenv("SSR_EXPORT_THREADS")) {
+    settings.threads = std::max(1, std::atoi(threads));
+  }
+  if (!g_exporter.start(settings)) {
+    return false;
+  }
+  fprintf(stderr, "export: %s -> %s (queue %d)\n", ssr::toString(settings.format), path, settings.queueDepth);
+  return true;
+}
+
+// Blend::span(AVX2 / SSE2 경로 + 나머지 꼬리)이 Blend::spanReference와 비트 단위로 같은지
+// 모든 (srcAlpha, src 채널, dst 채널) 조합으로 확인한다. 틀린 모드마다 첫 픽셀과 개수를 출력
+bool checkBlendSpans() {
+  constexpr ssr::BlendMode kModes[] = { ssr::BlendMode::Opaque, ssr::BlendMode::Alpha,
+                                        ssr::BlendMode::PremultipliedAlpha, ssr::BlendMode::Additive,
+                                        ssr::BlendMode::Multiply };
+  // dst가 한 채널의 256값을 모두 지나고, SIMD 폭의 배수가 아니어서 꼬리도 지난다
+  constexpr size_t kSpan = 256 + 7;
+  std::vector<uint32_t> src(kSpan);
+  std::vector<uint32_t> dst(kSpan);
+  std::vector<uint32_t> expected(kSpan);
+  std::vector<uint32_t> actual(kSpan);
+  for (size_t i = 0; i < kSpan; ++i) {
+    // 채널마다 다른 값이라 채널이 섞이면 드러난다
+    const uint32_t d = (uint32_t)(i & 0xFF);
+    dst[i] = (d << 24) | (d << 16) | ((255 - d) << 8) | (d ^ 0xA5);
+  }
+
+  bool ok = true;
+  for (ssr::BlendMode mode : kModes) {
+    uint64_t mismatches = 0;
+    for (uint32_t a = 0; a < 256; ++a) {
+      for (uint32_t s = 0; s < 256; ++s) {
+        const uint32_t color = (a << 24) | (s << 16) | ((255 - s) << 8) | (s ^ 0x5A);
+        std::fill(src.begin(), src.end(), color);
+        expected = dst;
+        actual = dst;
+        ssr::Blend::spanReference(mode, src.data(), expected.data(), kSpan);
+        ssr::Blend::span(mode, src.data(), actual.data(), kSpan);
+        for (size_t i = 0; i < kSpan; ++i) {
+          if (actual[i] != expected[i] && mismatches++ == 0) {
+            printf("[CHECK] blend %s: src 0x%08X dst 0x%08X -> 0x%08X, reference 0x%08X\n", ssr::toString(mode),
+                   src[i], dst[i], actual[i], expected[i]);
+          }
+        }
+      }
+    }
+    printf("[CHECK] blend %s: %llu mismatches in %llu pixels\n", ssr::toString(mode), (unsigned long long)mismatches,
+           (unsigned long long)(256 * 256 * kSpan));
+    ok = ok && mismatches == 0;
+  }
+  return ok;
+}
+
+// 헤드리스 모드 (SSR_SIM_TEST=1). 창과 SDL 비디오 없이 실제 래스터라이저로 N프레임을 그린다
+//   SSR_SIM_CHECK=1        그리지 않고 SIMD 커널을 스칼라 기준 구현과 비교만 한다 (checkBlendSpans). 틀리면 종료 코드 1
+//   SSR_SIM_FRAMES=N       프레임 수 (기본 5)
+//   SSR_SIM_SIZE=WxH       해상도 (기본 720x640)
+//   SSR_SIM_OUTPUT=path    있으면 프레임마다 내보낸다 (startExporter, 백그라운드 인코드). 예: thumbs/frame_%03d.png
+// 시간은 프레임당 1/60초로 고정이라 같은 설정이면 같은 이미지가 나온다. 카메라 입력은 simulateInputForFrame
+int runSimulation() {
+  const char* checkEnv = std::getenv("SSR_SIM_CHECK");
+  if (checkEnv != nullptr && (strcmp(checkEnv, "1") == 0 || strcmp(checkEnv, "true") == 0 ||
+                              strcmp(checkEnv, "TRUE") == 0)) {
+    return checkBlendSpans() ? 0 : 1;
+  }
+  const char* framesEnv = std::getenv("SSR_SIM_FRAMES");
+  const int frameCount = framesEnv != nullptr ? std::max(0, std::atoi(framesEnv)) : 5;
+  const char* sizeEnv = std::getenv("SSR_SIM_SIZE");
+  if (sizeEnv != nullptr) {
+    int width = 0;
+    int height = 0;
+    if (sscanf(sizeEnv, "%dx%d", &width, &height) == 2 && width > 0 && height > 0) {
+      g_screenWidth = width;
+      g_screenHeight = height;
+    } else {
+      printf("SSR_SIM_SIZE: expected WxH, got '%s'\n", sizeEnv);
+    }
+  }
+  const char* outputPattern = std::getenv("SSR_SIM_OUTPUT");
+  constexpr double kSimFrameMs = 1000.0 / 60.0;
+
+  g_camera.m_aspect = (float)g_screenWidth / g_screenHeight;
+  g_camera.m_fov = 45.0f;
+  g_camera.m_eye = { 0.0f, 0.0f, -5.0f };
+  g_camera.m_at = { 0.0f, 0.0f, 1.0f };
+  g_frameBufferLayout = frameBufferLayoutFromEnv();
+  depthStateFromEnv();
+  g_hiZEnabled = hiZEnabledFromEnv();
+  initMatrices((float)g_screenWidth, (float)g_screenHeight);
+  initMesh();
+  initLights();
+  g_threadPool = std::make_unique<ssr::ThreadPool>();
+  initPostProcess();
+  if (outputPattern != nullptr && !startExporter(outputPattern, frameCount > 1)) {
+    return 1;
+  }
+  printf("[SIM] %d frames at %dx%d\n", frameCount, g_screenWidth, g_screenHeight);
+
+  for (int frame = 0; frame < frameCount; ++frame) {
+    simulateInputForFrame(frame);
+    logFrameState(frame);
+    beginFrame();
+    drawFrame(frame == 0 ? 0.0 : kSimFrameMs, false);
+  }
+  g_exporter.finish();
+  return 0;
+}
+
 #pragma mark Main func
 
 int main(int argc, char **argv)
 {
   srand((unsigned)time(nullptr));
 
-  const bool sim_test = isSimTestEnabled();
-  const int sim_total_frames = 5;
-
-  if (sim_test) {
-    g_camera.m_aspect = (float)SCREEN_WIDTH / SCREEN_HEIGHT;
-    g_camera.m_fov = 45.0f;
-    g_camera.m_eye = { 0.0f, 0.0f, -5.0f };
-    g_camera.m_at = { 0.0f, 0.0f, 1.0f };
-    initMatrices((float)SCREEN_WIDTH, (float)SCREEN_HEIGHT);
-    initMesh();
-
-    for (int frame = 0; frame < sim_total_frames; ++frame) {
-      simulateInputForFrame(frame);
-      logFrameState(frame);
-    }
-    return 0;
+  if (isSimTestEnabled()) {
+    return runSimulation();
   }
 
+  // 창 표면 출력은 SDL_Renderer를 만들지 않아야 하므로 창을 만들기 전에 정한다
+  g_presentMode = presentModeFromEnv();
   g_program = ssr::SDLProgram::instance();
-  if (g_program->init(400, 0, SCREEN_WIDTH, SCREEN_HEIGHT) == false) {
+  if (g_program->init(400, 0, g_screenWidth, g_screenHeight,
+                      g_presentMode == PresentMode::Surface ? ssr::SDLRenderer::Backend::WindowSurface
+                                                            : ssr::SDLRenderer::Backend::Texture) == false) {
     return 1;
   }
 
   ssr::SDLRenderer &renderer = g_program->renderer();
 
   // 메모리에 상주하는 프레임버퍼 생성
-  g_frameBuffer = new unsigned int[g_program->width() * g_program->height() * 4];
-  g_screenTexture = SDL_CreateTexture(renderer.native(), SDL_PIXELFORMAT_RGBA8888, 
-                                          SDL_TEXTUREACCESS_STREAMING, SCREEN_WIDTH, SCREEN_HEIGHT);
-  if(g_screenTexture == nullptr) {
-    std::cout << "Failed to create g_screenTexture \n";
-    return 1;
+  g_frameBufferLayout = frameBufferLayoutFromEnv();
+  depthStateFromEnv();
+  g_hiZEnabled = hiZEnabledFromEnv();
+  g_frameBuffer.resize(g_screenWidth, g_screenHeight, g_msaaSamples, g_frameBufferLayout, g_depthFormat);
+  printf("frame buffer: %dx%d, %s layout, depth %s (%s)\n", g_screenWidth, g_screenHeight,
+         ssr::toString(g_frameBufferLayout), ssr::depth::toString(g_depthFormat),
+         ssr::depth::toString(g_depthCompare));
+  if (g_presentMode == PresentMode::Surface) {
+    SDL_Surface* surface = renderer.windowSurface();
+    printf("window surface: %s\n", SDL_GetPixelFormatName(surface->format->format));
+  } else {
+    // 프레임버퍼는 0xAARRGGBB이므로 그대로 올릴 수 있는 형식을 렌더러와 맞춘다 (이전의 RGBA8888은 채널이 어긋났다)
+    const Uint32 screenFormat = renderer.negotiateTextureFormat(g_program->window(), g_swapRedBlue);
+    printf("screen texture: %s (window %s)%s\n", SDL_GetPixelFormatName(screenFormat),
+           SDL_GetPixelFormatName(SDL_GetWindowPixelFormat(g_program->window())),
+           g_swapRedBlue ? ", red / blue swapped in the final write" : "");
+    g_screenTextureFormat = screenFormat;
+    if (ensureScreenTexture(renderer, g_screenWidth, g_screenHeight) == false) {
+      std::cout << "Failed to create g_screenTexture \n";
+      return 1;
+    }
+  }
+  printf("present: %s\n", toString(g_presentMode));
+  framePacingFromEnv(renderer);
+  if (g_framePacer.mode() != ssr::FramePacer::Mode::Unlimited) {
+    printf("frame pacer: %s %.1f fps\n", ssr::toString(g_framePacer.mode()), g_framePacer.targetFps());
+  }
+  if (const char* exportPath = std::getenv("SSR_EXPORT")) {
+    if (!startExporter(exportPath, true)) {
+      return 1;
+    }
   }
   
   // 카메라 설정
@@ -632,6 +2014,15 @@ int main(int argc, char **argv)
   initMatrices((float)g_program->width(), (float)g_program->height());
 
   initMesh();
+  initLights();
+  g_threadPool = std::make_unique<ssr::ThreadPool>();
+  initPostProcess();
+
+  g_pipelined = pipelineEnabledFromEnv();
+  if (g_pipelined) {
+    printf("pipeline: render thread + present thread (triple buffer)\n");
+    return runPipelined(renderer);
+  }
 
   // Main loop
   g_program->updateTime();
@@ -648,6 +2039,8 @@ int main(int argc, char **argv)
       {
       case SDL_QUIT:
       {
+        logFramePacingSummary();
+        g_exporter.finish();
         g_program->quit();
         return 0;
       }
@@ -656,6 +2049,17 @@ int main(int argc, char **argv)
         handleKeyInput(event);
         break;
       }
+      case SDL_WINDOWEVENT:
+      {
+        if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+          g_program->resize(event.window.data1, event.window.data2);
+          resizeScreen(event.window.data1, event.window.data2);
+          if (ensureScreenTexture(renderer, g_screenWidth, g_screenHeight) == false) {
+            printf("Failed to recreate g_screenTexture: %s\n", SDL_GetError());
+          }
+        }
+        break;
+      }
       default:
       {
         break;
@@ -664,21 +2068,47 @@ int main(int argc, char **argv)
     }
     
     // Update rendering objects
-    memset((char*)g_frameBuffer, 0, sizeof(int) * SCREEN_WIDTH * SCREEN_HEIGHT);
-    const size_t depthSize = SCREEN_WIDTH * SCREEN_HEIGHT;
-    if (g_depthBuffer.size() != depthSize) {
-      g_depthBuffer.assign(depthSize, 1.0f);
-    } else {
-      std::fill(g_depthBuffer.begin(), g_depthBuffer.end(), 1.0f);
+    beginFrame();
+
+    // 창 표면은 시스템 메모리라 리졸브부터 바로 쓴다. 화면 텍스처는 후처리의 마지막 픽셀 패스 묶음이
+    // 인코드하면서 바로 쓸 수 있을 때, 또는 R / B를 바꿔야 해서 어차피 한 번 훑을 때 (복사하면서 바꿈)만 잠근다.
+    // 아니면 잠가도 복사가 하나 늘 뿐이라 SDL_UpdateTexture
+    SDL_Surface* windowSurface = nullptr;
+    if (g_presentMode == PresentMode::Surface) {
+      windowSurface = bindWindowSurface(renderer);
+    } else if (g_presentMode == PresentMode::Lock &&
+               (g_swapRedBlue || (g_postProcess.endsWithPixelGroup() && !exportThisFrame()))) {
+      void* texturePixels = nullptr;
+      int texturePitch = 0;
+      if (SDL_LockTexture(g_screenTexture, nullptr, &texturePixels, &texturePitch) == 0 && texturePitch % 4 == 0) {
+        g_presentTarget = static_cast<uint32_t*>(texturePixels);
+        g_presentTargetPitch = texturePitch / 4;
+      } else {
+        // 잠글 수 없거나 pitch가 픽셀 단위가 아니면 복사 경로로 계속
+        if (texturePixels != nullptr) {
+          SDL_UnlockTexture(g_screenTexture);
+        }
+        printf("SDL_LockTexture unusable (%s), falling back to SDL_UpdateTexture\n", SDL_GetError());
+        g_presentMode = PresentMode::Copy;
+      }
     }
 
-    renderMeshTextured(g_program->delta());
+    drawFrame(g_program->delta(), g_swapRedBlue);
 
-    SDL_UpdateTexture(g_screenTexture, nullptr, g_frameBuffer, SCREEN_WIDTH * 4);
-    SDL_RenderCopy(renderer.native(), g_screenTexture, nullptr, nullptr);
+    if (g_presentMode == PresentMode::Surface) {
+      presentWindowSurface(windowSurface);
+    } else {
+      if (g_presentTarget != nullptr) {
+        SDL_UnlockTexture(g_screenTexture);
+        g_presentTarget = nullptr;
+      } else {
+        SDL_UpdateTexture(g_screenTexture, nullptr, g_frameBuffer.output(), g_frameBuffer.outputPitch() * 4);
+      }
+      SDL_RenderCopy(renderer.native(), g_screenTexture, nullptr, nullptr);
+    }
     renderer.present();
 
-    SDL_Delay(1);
+    reportFramePacing(g_framePacer.wait());
   }
 
   return 0;
@@ -7,6 +7,10 @@
 
 #include "Math.hpp"
 
+#include <algorithm>
+
+#include "FastMath.hpp"
+
 namespace ssr {
 
 Vector2::Vector2() : x(0.0f), y(0.0f) {}
@@ -86,9 +90,10 @@ bool Vector3::operator==(const Vector3& other) const {
 }
 
 Vector3 Vector3::normalize() const {
-  const float mag = (float)std::sqrt(this->x * this->x + this->y * this->y +
-                                     this->z * this->z);
-  return (*this) / mag;
+  // sqrt + 나눗셈 3번 대신 rsqrt 한 번과 곱셈. 영 벡터는 NaN 대신 영 벡터로 (rsqrt(0)은 NaN)
+  const float lengthSq = this->x * this->x + this->y * this->y + this->z * this->z;
+  const float invMag = fastmath::rsqrt(std::max(lengthSq, 1e-12f));
+  return (*this) * invMag;
 }
 
 std::string Vector3::toString() const {
@@ -315,9 +320,8 @@ void Matrix4x4::rotate(float x, float y, float z) {
 }
 
 void Matrix4x4::rotateX(float deg) {
-  static const float DEG2RAD = acos(-1.0f) / 180;
-  float cs = (float)cos(deg * DEG2RAD);
-  float ss = (float)sin(deg * DEG2RAD);
+  float cs, ss;
+  fastmath::sincos(deg * fastmath::kDegToRad, ss, cs);
 
   this->m22 = cs;
   this->m23 = ss;
@@ -326,9 +330,8 @@ void Matrix4x4::rotateX(float deg) {
 }
 
 void Matrix4x4::rotateY(float deg) {
-  static const float DEG2RAD = acos(-1.0f) / 180;
-  float cs = (float)cos(deg * DEG2RAD);
-  float ss = (float)sin(deg * DEG2RAD);
+  float cs, ss;
+  fastmath::sincos(deg * fastmath::kDegToRad, ss, cs);
 
   this->m11 = cs;
   this->m13 = -ss;
@@ -337,9 +340,8 @@ void Matrix4x4::rotateY(float deg) {
 }
 
 void Matrix4x4::rotateZ(float deg) {
-  static const float DEG2RAD = acos(-1.0f) / 180;
-  float cs = (float)cos(deg * DEG2RAD);
-  float ss = (float)sin(deg * DEG2RAD);
+  float cs, ss;
+  fastmath::sincos(deg * fastmath::kDegToRad, ss, cs);
 
   this->m11 = cs;
   this->m12 = ss;
@@ -347,6 +349,51 @@ void Matrix4x4::rotateZ(float deg) {
   this->m22 = cs;
 }
 
+Matrix4x4 Matrix4x4::inverse() const {
+  // 2x2 소행렬식을 먼저 구해서 여인수를 조합 (위 두 행 / 아래 두 행)
+  const float s0 = m11 * m22 - m21 * m12;
+  const float s1 = m11 * m23 - m21 * m13;
+  const float s2 = m11 * m24 - m21 * m14;
+  const float s3 = m12 * m23 - m22 * m13;
+  const float s4 = m12 * m24 - m22 * m14;
+  const float s5 = m13 * m24 - m23 * m14;
+
+  const float c5 = m33 * m44 - m43 * m34;
+  const float c4 = m32 * m44 - m42 * m34;
+  const float c3 = m32 * m43 - m42 * m33;
+  const float c2 = m31 * m44 - m41 * m34;
+  const float c1 = m31 * m43 - m41 * m33;
+  const float c0 = m31 * m42 - m41 * m32;
+
+  const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  if (det == 0.0f) {
+    return Matrix4x4::identity;
+  }
+  const float invDet = 1.0f / det;
+
+  return {
+    ( m22 * c5 - m23 * c4 + m24 * c3) * invDet,
+    (-m12 * c5 + m13 * c4 - m14 * c3) * invDet,
+    ( m42 * s5 - m43 * s4 + m44 * s3) * invDet,
+    (-m32 * s5 + m33 * s4 - m34 * s3) * invDet,
+
+    (-m21 * c5 + m23 * c2 - m24 * c1) * invDet,
+    ( m11 * c5 - m13 * c2 + m14 * c1) * invDet,
+    (-m41 * s5 + m43 * s2 - m44 * s1) * invDet,
+    ( m31 * s5 - m33 * s2 + m34 * s1) * invDet,
+
+    ( m21 * c4 - m22 * c2 + m24 * c0) * invDet,
+    (-m11 * c4 + m12 * c2 - m14 * c0) * invDet,
+    ( m41 * s4 - m42 * s2 + m44 * s0) * invDet,
+    (-m31 * s4 + m32 * s2 - m34 * s0) * invDet,
+
+    (-m21 * c3 + m22 * c1 - m23 * c0) * invDet,
+    ( m11 * c3 - m12 * c1 + m13 * c0) * invDet,
+    (-m41 * s3 + m42 * s1 - m43 * s0) * invDet,
+    ( m31 * s3 - m32 * s1 + m33 * s0) * invDet,
+  };
+}
+
 void Matrix4x4::print() const {
   static const char* log = R"(
     [ %4.2f %4.2f %4.2f %4.2f ]
@@ -438,6 +485,27 @@ void setupPerspectiveProjectionMatrix(Matrix4x4& out, float fovY, float aspect,
   out.m44 = 0.0f;
 }
 
+void setupReversedPerspectiveProjectionMatrix(Matrix4x4& out, float fovY, float aspect, float near, float far) {
+  // 일반 투영의 z_ndc를 1 - z_ndc로 뒤집은 것
+  // z_ndc = -n / (f - n) + f * n / ((f - n) * z_view)  =>  z_view = n 에서 1, f 에서 0
+  setupPerspectiveProjectionMatrix(out, fovY, aspect, near, far);
+  out.m33 = -near / (far - near);
+  out.m43 = (near * far) / (far - near);
+}
+
+void setupOrthographicProjectionMatrix(Matrix4x4& out, float left, float right, float bottom, float top,
+                                       float near, float far) {
+  // https://www.songho.ca/opengl/gl_projectionmatrix.html (Orthographic Projection)
+  // Left-handed, row-vector 규약이므로 이동 성분은 m41..m43 에 둔다.
+  out.m11 = 2.0f / (right - left);
+  out.m22 = 2.0f / (top - bottom);
+  out.m33 = 1.0f / (far - near);
+  out.m41 = -(right + left) / (right - left);
+  out.m42 = -(top + bottom) / (top - bottom);
+  out.m43 = -near / (far - near);
+  out.m44 = 1.0f;
+}
+
 void setupViewportMatrix(Matrix4x4& out, float x, float y, float w, float h, float near, float far) {
   /*
   * https://www.songho.ca/opengl/gl_viewport.html
@@ -462,7 +530,14 @@ void setupViewportMatrix(Matrix4x4& out, float x, float y, float w, float h, flo
 }
 
 uint32_t lerpColor(uint32_t from, uint32_t to, float t) {
-  return (uint32_t)(from + t * (to - from));
+  // 채널 단위로 보간해야 자리 올림이 다른 채널로 번지지 않는다
+  uint32_t result = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    float a = (float)((from >> shift) & 0xFF);
+    float b = (float)((to >> shift) & 0xFF);
+    result |= ((uint32_t)(a + t * (b - a) + 0.5f) & 0xFF) << shift;
+  }
+  return result;
 }
 
 } // namespace math
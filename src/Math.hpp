@@ -159,6 +159,10 @@ struct Matrix4x4 {
 
   void rotateZ(float deg);
 
+  /// @brief 역행렬 (여인수 전개). 행렬식이 0이면 단위 행렬을 반환
+  /// 투영 행렬을 포함한 일반 4x4용. 화면 좌표에서 월드 좌표로 되돌릴 때 사용 (TAA 재투영)
+  Matrix4x4 inverse() const;
+
   void print() const;
 };
 
@@ -174,6 +178,19 @@ void setupCameraMatrix(Matrix4x4& out, const Vector3& eye, const Vector3& at, co
  */
 void setupPerspectiveProjectionMatrix(Matrix4x4& out, float fovY, float aspect, float near, float far);
 
+/**
+ * @brief 깊이를 뒤집은 원근 투영 매트릭스 반환 (near -> 1, far -> 0)
+ * DepthFormat::ReversedFloat32와 함께 쓴다. x, y와 w는 setupPerspectiveProjectionMatrix와 같다
+ */
+void setupReversedPerspectiveProjectionMatrix(Matrix4x4& out, float fovY, float aspect, float near, float far);
+
+/**
+ * @brief 직교 투영 매트릭스 반환 (Left-handed, z는 [0, 1]로 매핑)
+ * 방향광 그림자 맵처럼 원근이 없는 투영에 사용
+ */
+void setupOrthographicProjectionMatrix(Matrix4x4& out, float left, float right, float bottom, float top,
+                                       float near, float far);
+
 /**
  * @brief 뷰포트 행렬 구성
  * near, far는 기본값 각각 0, 1 사용
@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+// File: Multisample.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "Multisample.hpp"
+
+#include <cstring>
+
+#include "ColorSpace.hpp"
+
+namespace ssr {
+
+namespace msaa {
+
+namespace {
+
+const SamplePattern kPattern1x = { 1, { 0.5f }, { 0.5f } };
+
+// 축에 정렬된 에지에서도 4단계 커버리지가 나오도록 x, y 모두 서로 다른 위치
+const SamplePattern kPattern4x = {
+  4,
+  { 0.375f, 0.875f, 0.125f, 0.625f },
+  { 0.125f, 0.375f, 0.625f, 0.875f },
+};
+
+}  // namespace
+
+const SamplePattern& pattern(int sampleCount) {
+  return sampleCount == 4 ? kPattern4x : kPattern1x;
+}
+
+void resolve(const uint32_t* samples, int sampleCount, uint32_t* out, size_t pixelCount, bool linear) {
+  if (sampleCount != 4) {
+    std::memcpy(out, samples, pixelCount * sizeof(uint32_t));
+    return;
+  }
+
+  for (size_t i = 0; i < pixelCount; ++i) {
+    const uint32_t* s = samples + i * 4;
+    if (s[0] == s[1] && s[0] == s[2] && s[0] == s[3]) {
+      out[i] = s[0];
+      continue;
+    }
+
+    // 알파는 선형이므로 그대로 평균
+    const uint32_t a = ((s[0] >> 24) + (s[1] >> 24) + (s[2] >> 24) + (s[3] >> 24) + 2) >> 2;
+    uint32_t color = a << 24;
+    for (int shift = 0; shift < 24; shift += 8) {
+      if (linear) {
+        const uint32_t sum = srgb::decode12((uint8_t)(s[0] >> shift)) + srgb::decode12((uint8_t)(s[1] >> shift)) +
+                             srgb::decode12((uint8_t)(s[2] >> shift)) + srgb::decode12((uint8_t)(s[3] >> shift));
+        color |= (uint32_t)srgb::encode12((sum + 2) >> 2) << shift;
+      } else {
+        const uint32_t sum = ((s[0] >> shift) & 0xFF) + ((s[1] >> shift) & 0xFF) +
+                             ((s[2] >> shift) & 0xFF) + ((s[3] >> shift) & 0xFF);
+        color |= ((sum + 2) >> 2) << shift;
+      }
+    }
+    out[i] = color;
+  }
+}
+
+}  // namespace msaa
+
+}  // namespace ssr
@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+// File: Multisample.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ssr {
+
+/// @brief 멀티샘플 안티에일리어싱(MSAA) 샘플 패턴과 리졸브
+/// 래스터라이저는 픽셀마다 샘플 위치별 커버리지 마스크를 만들고 깊이는 샘플마다 테스트하지만
+/// 셰이딩은 픽셀당 한 번만 하고 그 색을 통과한 샘플에 복사한다.
+/// 샘플 버퍼는 픽셀 단위로 샘플을 붙여 둔다. 픽셀의 순서(행 우선 / 타일 우선)는 FrameBuffer가 정한다
+namespace msaa {
+
+constexpr int kMaxSamples = 4;
+
+/// @brief 픽셀 좌상단 기준 샘플 위치 [0, 1)
+struct SamplePattern {
+  int count;
+  float x[kMaxSamples];
+  float y[kMaxSamples];
+};
+
+/// @brief 1x: 픽셀 중심, 4x: 회전 격자 (D3D 표준 4x 패턴)
+/// 지원하지 않는 값은 1x로 처리한다
+const SamplePattern& pattern(int sampleCount);
+
+/// @brief 샘플을 평균해서 픽셀 하나로 (0xAARRGGBB)
+/// linear면 색 채널을 sRGB에서 선형으로 디코드해서 평균하고 다시 인코드한다.
+/// 샘플이 모두 같은 픽셀(삼각형 내부)은 평균 없이 복사한다.
+void resolve(const uint32_t* samples, int sampleCount, uint32_t* out, size_t pixelCount, bool linear);
+
+}  // namespace msaa
+
+}  // namespace ssr
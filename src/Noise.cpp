@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+// File: Noise.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "Noise.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ssr {
+
+namespace {
+
+// Perlin 노이즈의 12방향 그래디언트 (정육면체 모서리 중점)
+float gradientDot(uint8_t hash, float x, float y, float z) {
+  switch (hash % 12) {
+  case 0: return x + y;
+  case 1: return -x + y;
+  case 2: return x - y;
+  case 3: return -x - y;
+  case 4: return x + z;
+  case 5: return -x + z;
+  case 6: return x - z;
+  case 7: return -x - z;
+  case 8: return y + z;
+  case 9: return -y + z;
+  case 10: return y - z;
+  default: return -y - z;
+  }
+}
+
+float fade(float t) {
+  return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+float lerp(float a, float b, float t) {
+  return a + (b - a) * t;
+}
+
+// 격자 좌표를 period로 나눈 나머지로 해시해서 주기 경계에서 같은 그래디언트가 나오게 한다
+float periodicPerlin(const uint8_t* perm, float x, float y, float z,
+                     int periodXY, int periodT) {
+  const int ix = (int)std::floor(x), iy = (int)std::floor(y), iz = (int)std::floor(z);
+  const float fx = x - ix, fy = y - iy, fz = z - iz;
+
+  auto hash = [&](int cx, int cy, int cz) -> uint8_t {
+    cx = ((cx % periodXY) + periodXY) % periodXY;
+    cy = ((cy % periodXY) + periodXY) % periodXY;
+    cz = ((cz % periodT) + periodT) % periodT;
+    return perm[(perm[(perm[cx & 255] + cy) & 255] + cz) & 255];
+  };
+
+  const float n000 = gradientDot(hash(ix, iy, iz), fx, fy, fz);
+  const float n100 = gradientDot(hash(ix + 1, iy, iz), fx - 1, fy, fz);
+  const float n010 = gradientDot(hash(ix, iy + 1, iz), fx, fy - 1, fz);
+  const float n110 = gradientDot(hash(ix + 1, iy + 1, iz), fx - 1, fy - 1, fz);
+  const float n001 = gradientDot(hash(ix, iy, iz + 1), fx, fy, fz - 1);
+  const float n101 = gradientDot(hash(ix + 1, iy, iz + 1), fx - 1, fy, fz - 1);
+  const float n011 = gradientDot(hash(ix, iy + 1, iz + 1), fx, fy - 1, fz - 1);
+  const float n111 = gradientDot(hash(ix + 1, iy + 1, iz + 1), fx - 1, fy - 1, fz - 1);
+
+  const float u = fade(fx), v = fade(fy), w = fade(fz);
+  return lerp(lerp(lerp(n000, n100, u), lerp(n010, n110, u), v),
+              lerp(lerp(n001, n101, u), lerp(n011, n111, u), v), w);
+}
+
+}  // namespace
+
+void NoiseVolume::generate(int size, int depth, int frequency, int timeFrequency, int octaves, uint32_t seed) {
+  m_size = size;
+  m_depth = depth;
+  m_texels.resize((size_t)size * size * depth);
+
+  // 시드로 섞은 순열 테이블 (xorshift)
+  uint8_t perm[256];
+  std::iota(perm, perm + 256, 0);
+  uint32_t state = seed != 0 ? seed : 0x9E3779B9u;
+  for (int i = 255; i > 0; --i) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    std::swap(perm[i], perm[state % (uint32_t)(i + 1)]);
+  }
+
+  float amplitudeSum = 0.0f;
+  for (int o = 0, amplitude = 1; o < octaves; ++o) {
+    amplitudeSum += 1.0f / (float)amplitude;
+    amplitude *= 2;
+  }
+
+  for (int z = 0; z < depth; ++z) {
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        float value = 0.0f;
+        float amplitude = 1.0f;
+        int periodXY = frequency;
+        int periodT = timeFrequency;
+        for (int o = 0; o < octaves; ++o) {
+          value += amplitude * periodicPerlin(perm,
+                                              (float)x / size * periodXY,
+                                              (float)y / size * periodXY,
+                                              (float)z / depth * periodT,
+                                              periodXY, periodT);
+          amplitude *= 0.5f;
+          periodXY *= 2;
+          periodT *= 2;
+        }
+
+        // Perlin 값은 대략 [-1, 1]. fBm 진폭 합으로 나눈 뒤 [0, 255]로 저장
+        float normalized = value / amplitudeSum * 0.5f + 0.5f;
+        normalized = std::min(std::max(normalized, 0.0f), 1.0f);
+        m_texels[x + y * size + (size_t)z * size * size] = (uint8_t)(normalized * 255.0f + 0.5f);
+      }
+    }
+  }
+}
+
+float NoiseVolume::sample(float u, float v, float t) const {
+  // 텍셀 중심 기준 bilinear. 크기가 2의 거듭제곱이라 wrap은 & 연산으로 처리
+  const float x = u * m_size - 0.5f;
+  const float y = v * m_size - 0.5f;
+  const float z = t * m_depth;
+  const float fx0 = std::floor(x), fy0 = std::floor(y), fz0 = std::floor(z);
+  const float fx = x - fx0, fy = y - fy0, fz = z - fz0;
+
+  const int mask = m_size - 1;
+  const int maskT = m_depth - 1;
+  const int x0 = (int)fx0 & mask, x1 = (x0 + 1) & mask;
+  const int y0 = (int)fy0 & mask, y1 = (y0 + 1) & mask;
+  const int z0 = (int)fz0 & maskT, z1 = (z0 + 1) & maskT;
+
+  const size_t slice = (size_t)m_size * m_size;
+  const uint8_t* s0 = m_texels.data() + z0 * slice;
+  const uint8_t* s1 = m_texels.data() + z1 * slice;
+  const int r0 = y0 * m_size, r1 = y1 * m_size;
+
+  const float a = lerp(lerp(s0[r0 + x0], s0[r0 + x1], fx), lerp(s0[r1 + x0], s0[r1 + x1], fx), fy);
+  const float b = lerp(lerp(s1[r0 + x0], s1[r0 + x1], fx), lerp(s1[r1 + x0], s1[r1 + x1], fx), fy);
+  return lerp(a, b, fz) * (1.0f / 255.0f);
+}
+
+}  // namespace ssr
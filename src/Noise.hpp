@@ -0,0 +1,42 @@
+//------------------------------------------------------------------------------
+// File: Noise.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ssr {
+
+/// @brief 시작할 때 한 번 만들어 두는 타일링 가능한 3D 노이즈 텍스처
+/// x, y는 텍스처 좌표, z는 시간 축이다. 세 축 모두 주기적(periodic) Perlin 노이즈로 만들어서
+/// 어느 방향으로 wrap 해도 이음매가 없다. 픽셀 셰이딩에서는 노이즈를 계산하지 않고
+/// sample()로 텍셀 8개만 읽는다.
+class NoiseVolume {
+public:
+  /// @brief size x size x depth 볼륨 생성 (모두 2의 거듭제곱)
+  /// frequency는 xy 방향 기본 격자 수, timeFrequency는 시간 축 기본 격자 수.
+  /// octaves만큼 주파수를 2배씩 올리며 fBm으로 누적한다.
+  void generate(int size, int depth, int frequency, int timeFrequency, int octaves, uint32_t seed);
+
+  /// @brief 값 [0, 1]. u, v, t 모두 1 주기로 wrap. xy는 bilinear, t는 linear
+  float sample(float u, float v, float t) const;
+
+  int size() const { return m_size; }
+
+  int depth() const { return m_depth; }
+
+  bool empty() const { return m_texels.empty(); }
+
+private:
+  int m_size = 0;
+  int m_depth = 0;
+  // 한 텍셀 1바이트. 64x64x32 볼륨이 128KB로 캐시에 잘 머문다
+  std::vector<uint8_t> m_texels;
+};
+
+}  // namespace ssr
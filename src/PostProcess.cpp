@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+// File: PostProcess.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "PostProcess.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "ColorSpace.hpp"
+#include "SIMD.hpp"
+#include "ThreadPool.hpp"
+
+namespace ssr {
+
+namespace {
+
+inline float acesFilm(float x) {
+  return (x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f);
+}
+
+}  // namespace
+
+void PostProcessChain::addPixelPass(const char* name, PixelFunc fn, const bool* enabled) {
+  m_passes.push_back({ name, std::move(fn), nullptr, enabled });
+}
+
+void PostProcessChain::addFramePass(const char* name, FrameFunc fn, const bool* enabled) {
+  m_passes.push_back({ name, nullptr, std::move(fn), enabled });
+}
+
+bool PostProcessChain::endsWithPixelGroup() const {
+  for (auto it = m_passes.rbegin(); it != m_passes.rend(); ++it) {
+    if (it->enabled == nullptr || *it->enabled) {
+      return static_cast<bool>(it->pixel);
+    }
+  }
+  return false;
+}
+
+void PostProcessChain::run(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool,
+                           uint32_t* destination, int destinationPitch, bool swapRedBlue) {
+  m_lastSweepCount = 0;
+  m_lastSchedule.clear();
+
+  std::vector<const Pass*> group;
+  // target이 nullptr이면 제자리
+  auto flushGroup = [&](uint32_t* target, int targetPitch, bool swap) {
+    if (group.empty()) {
+      return;
+    }
+    runPixelGroup(group, pixels, width, height, pitchInPixels, target, targetPitch, swap, pool);
+    if (!m_lastSchedule.empty()) {
+      m_lastSchedule += " -> ";
+    }
+    for (size_t i = 0; i < group.size(); ++i) {
+      m_lastSchedule += (i == 0 ? "" : "+");
+      m_lastSchedule += group[i]->name;
+    }
+    ++m_lastSweepCount;
+    group.clear();
+  };
+
+  for (const Pass& pass : m_passes) {
+    if (pass.enabled != nullptr && !*pass.enabled) {
+      continue;
+    }
+    if (pass.pixel) {
+      group.push_back(&pass);
+      continue;
+    }
+    flushGroup(nullptr, 0, false);
+    pass.frame(pixels, width, height, pitchInPixels, pool);
+    if (!m_lastSchedule.empty()) {
+      m_lastSchedule += " -> ";
+    }
+    m_lastSchedule += pass.name;
+    ++m_lastSweepCount;
+  }
+  if (!group.empty() || (destination == nullptr && !swapRedBlue)) {
+    flushGroup(destination, destinationPitch, swapRedBlue);
+    return;
+  }
+  // 마지막이 프레임 패스이거나 켜진 패스가 없으면 복사하면서 (필요하면 R / B를 바꿔서) 쓰고,
+  // 복사할 곳도 없으면 제자리에서 바꾸기만
+  if (destination != nullptr) {
+    post::copyFrame(pixels, pitchInPixels, destination, destinationPitch, width, height, swapRedBlue, pool);
+    m_lastSchedule += m_lastSchedule.empty() ? "copy" : " -> copy";
+  } else {
+    post::swapRedBlue(pixels, width, height, pitchInPixels, pool);
+    m_lastSchedule += m_lastSchedule.empty() ? "swap-rb" : " -> swap-rb";
+  }
+  ++m_lastSweepCount;
+}
+
+void PostProcessChain::runPixelGroup(const std::vector<const Pass*>& group, uint32_t* pixels, int width,
+                                     int height, int pitchInPixels, uint32_t* destination, int destinationPitch,
+                                     bool swapRedBlue, ThreadPool& pool) {
+  const bool linear = srgb::enabled();
+  // 인코드가 채널 위치를 정하므로 R / B 교환은 자리만 바꾸면 된다
+  const int redShift = swapRedBlue ? 0 : 16;
+  const int blueShift = swapRedBlue ? 16 : 0;
+
+  pool.parallelFor(height, ThreadPool::kRowBand, [&](int y0, int y1) {
+    // 한 행 분량의 작업 버퍼만 두고 묶음 안에서 재사용 (L1에 머문다)
+    // 패스가 Float4로 끝까지 돌 수 있게 4의 배수로 늘려 둔다
+    const size_t stride = ((size_t)width + 3) & ~(size_t)3;
+    std::vector<float> planes(3 * stride, 0.0f);
+    PixelRow row = { planes.data(), planes.data() + stride, planes.data() + 2 * stride, 0, width, height };
+
+    for (int y = y0; y < y1; ++y) {
+      const uint32_t* line = pixels + (size_t)y * pitchInPixels;
+      for (int x = 0; x < width; ++x) {
+        const uint32_t c = line[x];
+        row.r[x] = srgb::toWorking(c >> 16, linear);
+        row.g[x] = srgb::toWorking(c >> 8, linear);
+        row.b[x] = srgb::toWorking(c, linear);
+      }
+
+      row.y = y;
+      for (const Pass* pass : group) {
+        pass->pixel(row);
+      }
+
+      uint32_t* out = destination != nullptr ? destination + (size_t)y * destinationPitch
+                                             : pixels + (size_t)y * pitchInPixels;
+      for (int x = 0; x < width; ++x) {
+        out[x] = (line[x] & 0xFF000000u) | (srgb::fromWorking(row.r[x], linear) << redShift) |
+                  (srgb::fromWorking(row.g[x], linear) << 8) | (srgb::fromWorking(row.b[x], linear) << blueShift);
+      }
+    }
+  });
+}
+
+namespace post {
+
+namespace {
+
+inline Float4 acesFilm4(Float4 x) {
+  const Float4 numerator = x * (Float4::splat(2.51f) * x + Float4::splat(0.03f));
+  const Float4 denominator = x * (Float4::splat(2.43f) * x + Float4::splat(0.59f)) + Float4::splat(0.14f);
+  return numerator / denominator;
+}
+
+}  // namespace
+
+void ToneMapping::process(const PixelRow& row) const {
+  const Float4 scale = Float4::splat(exposure);
+  const Float4 invWhite = Float4::splat(1.0f / acesFilm(whitePoint * exposure));
+  float* planes[3] = { row.r, row.g, row.b };
+  for (float* p : planes) {
+    for (int x = 0; x < row.width; x += 4) {
+      (acesFilm4(Float4::load(p + x) * scale) * invWhite).store(p + x);
+    }
+  }
+}
+
+void ColorGrading::process(const PixelRow& row) const {
+  const Float4 midGrey = Float4::splat(0.18f);
+  const Float4 c = Float4::splat(contrast);
+  const Float4 s = Float4::splat(saturation);
+  const Float4 gainR = Float4::splat(gain.x), gainG = Float4::splat(gain.y), gainB = Float4::splat(gain.z);
+  const Float4 lumaR = Float4::splat(0.2126f), lumaG = Float4::splat(0.7152f), lumaB = Float4::splat(0.0722f);
+  const Float4 zero = Float4::splat(0.0f);
+  for (int x = 0; x < row.width; x += 4) {
+    // 대비: 18% 회색을 고정점으로 기울기만 바꿈
+    const Float4 r = (Float4::load(row.r + x) - midGrey) * c + midGrey;
+    const Float4 g = (Float4::load(row.g + x) - midGrey) * c + midGrey;
+    const Float4 b = (Float4::load(row.b + x) - midGrey) * c + midGrey;
+    // 채도: 휘도 쪽으로 당기거나 밀어냄
+    const Float4 luma = lumaR * r + lumaG * g + lumaB * b;
+    max((luma + (r - luma) * s) * gainR, zero).store(row.r + x);
+    max((luma + (g - luma) * s) * gainG, zero).store(row.g + x);
+    max((luma + (b - luma) * s) * gainB, zero).store(row.b + x);
+  }
+}
+
+void Vignette::process(const PixelRow& row) const {
+  // 짧은 변 절반을 1로 두어 화면 비율과 무관하게 원형
+  const float invHalf = 2.0f / (float)std::min(row.width, row.height);
+  const float dy = ((float)row.y + 0.5f - row.height * 0.5f) * invHalf;
+  const Float4 dy2 = Float4::splat(dy * dy);
+  const Float4 innerV = Float4::splat(inner);
+  const Float4 invRange = Float4::splat(1.0f / std::max(outer - inner, 1e-4f));
+  const Float4 intensityV = Float4::splat(intensity);
+  const Float4 zero = Float4::splat(0.0f), one = Float4::splat(1.0f);
+  const Float4 two = Float4::splat(2.0f), three = Float4::splat(3.0f);
+  const Float4 step = Float4::splat(4.0f * invHalf);
+  const float x0 = (0.5f - row.width * 0.5f) * invHalf;
+  const float lanes[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+  Float4 dx = Float4::splat(x0) + Float4::splat(invHalf) * Float4::load(lanes);
+  for (int x = 0; x < row.width; x += 4) {
+    const Float4 d = sqrt(dx * dx + dy2);
+    Float4 t = min(max((d - innerV) * invRange, zero), one);
+    t = t * t * (three - two * t);
+    const Float4 factor = one - intensityV * t;
+    (Float4::load(row.r + x) * factor).store(row.r + x);
+    (Float4::load(row.g + x) * factor).store(row.g + x);
+    (Float4::load(row.b + x) * factor).store(row.b + x);
+    dx = dx + step;
+  }
+}
+
+void copyRow(const uint32_t* source, uint32_t* destination, int width, bool swapRedBlue) {
+  if (!swapRedBlue) {
+    std::memcpy(destination, source, (size_t)width * sizeof(uint32_t));
+    return;
+  }
+  for (int x = 0; x < width; ++x) {
+    destination[x] = swizzleRedBlue(source[x]);
+  }
+}
+
+void copyFrame(const uint32_t* source, int sourcePitch, uint32_t* destination, int destinationPitch, int width,
+               int height, bool swapRedBlue, ThreadPool& pool) {
+  pool.parallelFor(height, ThreadPool::kRowBand, [&](int y0, int y1) {
+    for (int y = y0; y < y1; ++y) {
+      copyRow(source + (size_t)y * sourcePitch, destination + (size_t)y * destinationPitch, width, swapRedBlue);
+    }
+  });
+}
+
+void swapRedBlue(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool) {
+  pool.parallelFor(height, ThreadPool::kRowBand, [&](int y0, int y1) {
+    for (int y = y0; y < y1; ++y) {
+      uint32_t* row = pixels + (size_t)y * pitchInPixels;
+      for (int x = 0; x < width; ++x) {
+        row[x] = swizzleRedBlue(row[x]);
+      }
+    }
+  });
+}
+
+}  // namespace post
+
+}  // namespace ssr
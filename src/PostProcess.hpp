@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+// File: PostProcess.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Math.hpp"
+
+namespace ssr {
+
+class ThreadPool;
+
+/// @brief 픽셀 패스에 넘기는 한 행. 색은 작업 공간 float (sRGB 켜짐이면 선형) R / G / B 평면
+/// 각 평면은 width를 4의 배수로 올린 길이만큼 있어서 Float4로 끝까지 읽고 써도 된다 (남는 칸은 버림)
+struct PixelRow {
+  float* r;
+  float* g;
+  float* b;
+  int y;
+  int width;
+  int height;
+};
+
+/// @brief 래스터화 뒤, SDL_UpdateTexture 전에 프레임버퍼에 차례로 적용하는 후처리 체인
+/// 패스는 두 종류다.
+///   픽셀 패스: 자기 픽셀만 읽고 쓰는 효과 (톤 매핑, 색 보정, 비네트). 연속된 픽셀 패스는 하나로 합쳐서
+///             행 묶음마다 한 번 디코드 -> 모든 패스 -> 한 번 인코드 (프레임버퍼를 한 번만 훑는다)
+///   프레임 패스: 이웃이나 이전 프레임을 읽는 효과 (TAA, 블룸, FXAA). 합치기의 경계가 되고
+///             프레임버퍼 전체를 받아 스스로 병렬화한다
+/// 꺼진 패스는 건너뛰므로 사이에 있던 프레임 패스가 꺼지면 양쪽 픽셀 패스가 한 번에 합쳐진다.
+class PostProcessChain {
+public:
+  using PixelFunc = std::function<void(const PixelRow& row)>;
+  using FrameFunc = std::function<void(uint32_t* pixels, int width, int height, int pitchInPixels,
+                                       ThreadPool& pool)>;
+
+  /// @brief enabled가 nullptr이면 항상 켜짐. 가리키는 bool은 체인보다 오래 살아야 한다
+  void addPixelPass(const char* name, PixelFunc fn, const bool* enabled = nullptr);
+  void addFramePass(const char* name, FrameFunc fn, const bool* enabled = nullptr);
+
+  /// @brief 켜진 패스를 등록 순서대로 적용
+  /// destination이 있으면 최종 결과는 거기에만 쓴다 (잠근 화면 텍스처처럼 읽으면 안 되는 메모리, 한 행 destinationPitch개).
+  /// 마지막 훑기가 픽셀 패스 묶음이면 그 인코드가 destination에 바로 쓰고 (이때 pixels에는 그 묶음 전의 값이 남는다),
+  /// 아니면 끝에 한 번 복사한다. 패스는 모두 pixels에서 읽는다
+  /// swapRedBlue면 최종 결과를 0xAABBGGRR로 쓴다 (화면 형식이 R / B 반대일 때). 마지막 인코드나 복사가 바꿔 쓰므로
+  /// 훑기가 늘지 않고, 둘 다 없을 때(destination 없음 + 마지막이 픽셀 패스 묶음이 아님)만 제자리에서 한 번 바꾼다
+  void run(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool,
+           uint32_t* destination = nullptr, int destinationPitch = 0, bool swapRedBlue = false);
+
+  /// @brief 지금 켜진 패스 중 마지막이 픽셀 패스인지 (그러면 run의 destination에 추가 훑기 없이 쓴다)
+  bool endsWithPixelGroup() const;
+
+  /// @brief 마지막 run에서 프레임버퍼를 훑은 횟수 (합친 픽셀 패스 묶음 + 프레임 패스)
+  int lastSweepCount() const { return m_lastSweepCount; }
+  /// @brief 마지막 run의 실행 순서. 합쳐진 픽셀 패스는 "a+b+c"로 표시
+  const std::string& lastSchedule() const { return m_lastSchedule; }
+
+private:
+  struct Pass {
+    const char* name;
+    PixelFunc pixel;
+    FrameFunc frame;
+    const bool* enabled;
+  };
+
+  void runPixelGroup(const std::vector<const Pass*>& group, uint32_t* pixels, int width, int height,
+                     int pitchInPixels, uint32_t* destination, int destinationPitch, bool swapRedBlue,
+                     ThreadPool& pool);
+
+  std::vector<Pass> m_passes;
+  int m_lastSweepCount = 0;
+  std::string m_lastSchedule;
+};
+
+namespace post {
+
+/// @brief 필름 톤 커브 (Narkowicz의 ACES 근사). whitePoint가 1.0이 되도록 정규화해서
+/// 8비트 프레임버퍼의 흰색은 흰색으로 남고 중간 톤과 어두운 영역의 대비만 바뀐다
+struct ToneMapping {
+  float exposure = 1.0f;
+  float whitePoint = 1.0f;
+
+  void process(const PixelRow& row) const;
+};
+
+/// @brief 색 보정. 대비는 선형 18% 회색 기준, 채도는 Rec. 709 휘도 기준, gain은 채널별 곱
+struct ColorGrading {
+  float contrast = 1.0f;
+  float saturation = 1.0f;
+  Vector3 gain = { 1.0f, 1.0f, 1.0f };
+
+  void process(const PixelRow& row) const;
+};
+
+/// @brief 화면 가장자리를 어둡게. 중심에서 잰 거리(짧은 변 절반 = 1)가 inner부터 outer까지
+/// smoothstep으로 intensity만큼 줄어든다
+struct Vignette {
+  float intensity = 0.35f;
+  float inner = 0.6f;
+  float outer = 1.5f;
+
+  void process(const PixelRow& row) const;
+};
+
+/// @brief 0xAARRGGBB <-> 0xAABBGGRR
+inline uint32_t swizzleRedBlue(uint32_t c) { return (c & 0xFF00FF00u) | ((c >> 16) & 0xFFu) | ((c & 0xFFu) << 16); }
+
+/// @brief 한 행 복사. swapRedBlue면 R / B를 바꿔 쓴다. source와 destination은 겹치면 안 된다
+void copyRow(const uint32_t* source, uint32_t* destination, int width, bool swapRedBlue);
+
+/// @brief 행 단위 복사. 읽지 않고 쓰기만 하므로 잠근 화면 텍스처로 내보낼 때 쓴다
+void copyFrame(const uint32_t* source, int sourcePitch, uint32_t* destination, int destinationPitch, int width,
+               int height, bool swapRedBlue, ThreadPool& pool);
+
+/// @brief 제자리에서 R / B 교환. 최종 결과를 쓰는 다른 훑기가 없을 때만 (run 참고)
+void swapRedBlue(uint32_t* pixels, int width, int height, int pitchInPixels, ThreadPool& pool);
+
+}  // namespace post
+
+}  // namespace ssr
@@ -22,7 +22,7 @@ SDLProgram* SDLProgram::instance() {
 
 SDLProgram::~SDLProgram() { quit(); }
 
-bool SDLProgram::init(int x, int y, int width, int height) {
+bool SDLProgram::init(int x, int y, int width, int height, SDLRenderer::Backend backend) {
   m_width = width;
   m_height = height;
 
@@ -39,7 +39,7 @@ bool SDLProgram::init(int x, int y, int width, int height) {
   }
 
   m_renderer = new SDLRenderer();
-  if(m_renderer->init(m_window, m_width, m_height) == false) {
+  if(m_renderer->init(m_window, m_width, m_height, backend) == false) {
     return false;
   }
 
@@ -78,6 +78,11 @@ unsigned SDLProgram::height() const {
   return m_height;
 }
 
+void SDLProgram::resize(unsigned width, unsigned height) {
+  m_width = width;
+  m_height = height;
+}
+
 void SDLProgram::updateTime() {
   m_lastTime = m_currentTime;
   m_currentTime = SDL_GetPerformanceCounter();
@@ -19,7 +19,8 @@ class SDLProgram {
 
   ~SDLProgram();
 
-  bool init(int x, int y, int width, int height);
+  bool init(int x, int y, int width, int height,
+            SDLRenderer::Backend backend = SDLRenderer::Backend::Texture);
 
   void quit();
 
@@ -35,6 +36,8 @@ class SDLProgram {
 
   unsigned height() const;
 
+  void resize(unsigned width, unsigned height);
+
   void updateTime();
 
   double delta() const;
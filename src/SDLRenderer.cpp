@@ -16,11 +16,42 @@ namespace ssr {
 
 SDLRenderer::SDLRenderer() {}
 
-SDLRenderer::~SDLRenderer() { SDL_DestroyRenderer(m_renderer); }
+namespace {
+
+// 프레임버퍼 한 픽셀(uint32_t 0xAARRGGBB)과 바이트 배치가 같거나 R / B만 바뀐 32비트 형식
+// RGB888 / BGR888은 위 8비트를 쓰지 않는 X 형식이라 알파 바이트가 그대로 있어도 된다
+struct DirectFormat {
+  Uint32 format;
+  bool swapRedBlue;
+};
+const DirectFormat kDirectFormats[] = {
+  { SDL_PIXELFORMAT_ARGB8888, false },
+  { SDL_PIXELFORMAT_RGB888, false },
+  { SDL_PIXELFORMAT_ABGR8888, true },
+  { SDL_PIXELFORMAT_BGR888, true },
+};
+
+}  // namespace
+
+SDLRenderer::~SDLRenderer() {
+  if (m_renderer != nullptr) {
+    SDL_DestroyRenderer(m_renderer);
+  }
+}
 
 SDL_Renderer* SDLRenderer::native() { return m_renderer; }
 
-bool SDLRenderer::init(SDL_Window* window, int w, int h) {
+bool SDLRenderer::init(SDL_Window* window, int w, int h, Backend backend) {
+  m_window = window;
+  m_backend = backend;
+  if (backend == Backend::WindowSurface) {
+    // 표면을 한 번 얻어 두어 SDL이 창 프레임버퍼를 만들게 한다. 이후 렌더러를 만들면 이 표면은 무효가 된다
+    if (SDL_GetWindowSurface(window) == nullptr) {
+      std::cout << "SDL_GetWindowSurface failed error: " << SDL_GetError() << std::endl;
+      return false;
+    }
+    return true;
+  }
   m_renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
   if (m_renderer == nullptr) {
     std::cout << "SDL_CreateRenderer failed error: " << SDL_GetError() << std::endl;
@@ -29,11 +60,78 @@ bool SDLRenderer::init(SDL_Window* window, int w, int h) {
   return true;
 }
 
-void SDLRenderer::clear() { SDL_RenderClear(m_renderer); }
+SDL_Surface* SDLRenderer::windowSurface() {
+  return m_backend == Backend::WindowSurface ? SDL_GetWindowSurface(m_window) : nullptr;
+}
+
+void SDLRenderer::clear() {
+  if (m_renderer != nullptr) {
+    SDL_RenderClear(m_renderer);
+  }
+}
+
+void SDLRenderer::present() {
+  if (m_backend == Backend::WindowSurface) {
+    SDL_UpdateWindowSurface(m_window);
+    return;
+  }
+  SDL_RenderPresent(m_renderer);
+}
 
-void SDLRenderer::present() { SDL_RenderPresent(m_renderer); }
+void SDLRenderer::flush() {
+  if (m_renderer != nullptr) {
+    SDL_RenderFlush(m_renderer);
+  }
+}
 
-void SDLRenderer::flush() { SDL_RenderFlush(m_renderer); }
+bool SDLRenderer::setVSync(bool enabled) {
+  if (m_renderer == nullptr) {
+    return false;
+  }
+  if (SDL_RenderSetVSync(m_renderer, enabled ? 1 : 0) != 0) {
+    std::cout << "SDL_RenderSetVSync failed error: " << SDL_GetError() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool SDLRenderer::isDirectFormat(Uint32 format, bool& swapRedBlue) {
+  for (const DirectFormat& direct : kDirectFormats) {
+    if (direct.format == format) {
+      swapRedBlue = direct.swapRedBlue;
+      return true;
+    }
+  }
+  swapRedBlue = false;
+  return false;
+}
+
+Uint32 SDLRenderer::negotiateTextureFormat(SDL_Window* window, bool& swapRedBlue) const {
+  swapRedBlue = false;
+  SDL_RendererInfo info;
+  if (SDL_GetRendererInfo(m_renderer, &info) != 0) {
+    std::cout << "SDL_GetRendererInfo failed error: " << SDL_GetError() << std::endl;
+    return SDL_PIXELFORMAT_ARGB8888;
+  }
+  const auto supported = [&info](Uint32 format) {
+    return std::find(info.texture_formats, info.texture_formats + info.num_texture_formats, format) !=
+           info.texture_formats + info.num_texture_formats;
+  };
+
+  // 1. 창 형식과 같은 것 (화면에 옮길 때도 변환 없음) 2. 나머지는 R / B를 바꾸지 않아도 되는 순서대로
+  const Uint32 windowFormat = SDL_GetWindowPixelFormat(window);
+  if (supported(windowFormat) && isDirectFormat(windowFormat, swapRedBlue)) {
+    return windowFormat;
+  }
+  for (const DirectFormat& direct : kDirectFormats) {
+    if (supported(direct.format)) {
+      swapRedBlue = direct.swapRedBlue;
+      return direct.format;
+    }
+  }
+  // 맞는 형식이 없으면 SDL이 업로드 때 변환한다
+  return SDL_PIXELFORMAT_ARGB8888;
+}
 
 }  // namespace ssr
 
@@ -15,6 +15,15 @@ namespace ssr {
 
 class SDLRenderer {
  public:
+  /// @brief 화면에 내보내는 경로
+  enum class Backend {
+    /// SDL_Renderer + 스트리밍 텍스처 (기본)
+    Texture,
+    /// SDL_Renderer 없이 창 표면(SDL_GetWindowSurface)에 바로 쓰고 SDL_UpdateWindowSurface.
+    /// GPU가 없는 환경에서 소프트웨어 SDL_Renderer 흉내 층과 그 복사를 건너뛴다. 같은 창에 렌더러와 함께 쓸 수 없다
+    WindowSurface,
+  };
+
   SDLRenderer();
 
   ~SDLRenderer();
@@ -25,17 +34,36 @@ class SDLRenderer {
   SDLRenderer(SDLRenderer&&) = delete;
   SDLRenderer& operator=(SDLRenderer&&) = delete;
 
-  bool init(SDL_Window* window, int x, int y);
+  bool init(SDL_Window* window, int x, int y, Backend backend = Backend::Texture);
+
+  Backend backend() const { return m_backend; }
 
+  /// @brief Texture 백엔드의 렌더러. WindowSurface 백엔드면 nullptr
   SDL_Renderer* native();
 
+  /// @brief WindowSurface 백엔드에서 이번 프레임에 쓸 창 표면. 창 크기가 바뀌면 다른 표면이 되므로 매 프레임 다시 얻는다
+  SDL_Surface* windowSurface();
+
   void clear();
 
   void present();
 
   void flush();
 
+  /// @brief present가 수직 동기를 기다리게 한다. WindowSurface 백엔드나 렌더러가 지원하지 않으면 false
+  bool setVSync(bool enabled);
+
+  /// @brief 화면 텍스처 형식 고르기. 렌더러가 지원하는 형식(SDL_GetRendererInfo) 중에서
+  /// 창 형식과 같고 프레임버퍼(0xAARRGGBB)를 그대로 올릴 수 있는 것을 우선한다. 업로드 때 SDL이 픽셀마다 변환하지 않도록
+  /// @param swapRedBlue 고른 형식이 R / B 순서가 반대(ABGR8888 / BGR888)면 true. 출력 전에 한 번 바꿔야 한다
+  Uint32 negotiateTextureFormat(SDL_Window* window, bool& swapRedBlue) const;
+
+  /// @brief 0xAARRGGBB 픽셀을 변환 없이 (swapRedBlue면 R / B만 바꿔서) 쓸 수 있는 32비트 형식인지
+  static bool isDirectFormat(Uint32 format, bool& swapRedBlue);
+
  private:
+  Backend m_backend = Backend::Texture;
+  SDL_Window* m_window = nullptr;
   SDL_Renderer* m_renderer = nullptr;
 
 };
@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+// File: SIMD.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+// 4-wide float SIMD 래퍼
+// x86은 SSE2, ARM(Apple Silicon)은 NEON, 그 외에는 스칼라 루프로 동작한다.
+// 셰이딩 코드는 이 타입만 사용하고 플랫폼별 intrinsic은 이 파일에만 둔다.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSR_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SSR_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define SSR_SIMD_SCALAR 1
+#include <cmath>
+#endif
+
+namespace ssr {
+
+struct Float4 {
+#if SSR_SIMD_SSE2
+  __m128 v;
+#elif SSR_SIMD_NEON
+  float32x4_t v;
+#else
+  float v[4];
+#endif
+
+  static Float4 splat(float s);
+
+  /// @brief 정렬되지 않은 메모리에서 4개 로드
+  static Float4 load(const float* p);
+
+  /// @brief 정렬되지 않은 메모리로 4개 저장
+  void store(float* p) const;
+};
+
+#if SSR_SIMD_SSE2
+
+inline Float4 Float4::splat(float s) { return { _mm_set1_ps(s) }; }
+inline Float4 Float4::load(const float* p) { return { _mm_loadu_ps(p) }; }
+inline void Float4::store(float* p) const { _mm_storeu_ps(p, v); }
+
+inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+inline Float4 min(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+inline Float4 max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+inline Float4 sqrt(Float4 a) { return { _mm_sqrt_ps(a.v) }; }
+
+/// @brief a > b 인 레인은 모든 비트가 1인 마스크
+inline Float4 greaterThan(Float4 a, Float4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+
+/// @brief 마스크 비트가 켜진 레인은 a, 아니면 b
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+  return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+}
+
+/// @brief 마스크 레인 중 하나라도 켜져 있는지
+inline bool any(Float4 mask) { return _mm_movemask_ps(mask.v) != 0; }
+
+/// @brief 마스크 레인 i가 켜져 있으면 비트 i가 1인 정수 [0, 15]
+inline int bitMask(Float4 mask) { return _mm_movemask_ps(mask.v); }
+
+inline float lane0(Float4 a) { return _mm_cvtss_f32(a.v); }
+
+// 아래는 fastmath(FastMath.hpp)가 쓰는 저수준 연산
+
+/// @brief 1/x 하드웨어 추정값 (상대 오차 약 2^-12)
+inline Float4 rcpEstimate(Float4 a) { return { _mm_rcp_ps(a.v) }; }
+
+/// @brief 1/sqrt(x) 하드웨어 추정값 (상대 오차 약 2^-12)
+inline Float4 rsqrtEstimate(Float4 a) { return { _mm_rsqrt_ps(a.v) }; }
+
+/// @brief 0 방향으로 버림
+inline Float4 truncate(Float4 a) { return { _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v)) }; }
+
+/// @brief 정수 값을 갖는 n에 대해 2^n. n은 [-126, 127]
+inline Float4 exp2Integer(Float4 n) {
+  __m128i e = _mm_add_epi32(_mm_cvttps_epi32(n.v), _mm_set1_epi32(127));
+  return { _mm_castsi128_ps(_mm_slli_epi32(e, 23)) };
+}
+
+/// @brief 양의 정규화 수 x = mantissa * 2^exponent, mantissa는 [1, 2)
+inline void splitExponent(Float4 x, Float4& exponent, Float4& mantissa) {
+  __m128i bits = _mm_castps_si128(x.v);
+  __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+  exponent.v = _mm_cvtepi32_ps(e);
+  mantissa.v = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)),
+                                             _mm_set1_epi32(0x3F800000)));
+}
+
+#elif SSR_SIMD_NEON
+
+inline Float4 Float4::splat(float s) { return { vdupq_n_f32(s) }; }
+inline Float4 Float4::load(const float* p) { return { vld1q_f32(p) }; }
+inline void Float4::store(float* p) const { vst1q_f32(p, v); }
+
+inline Float4 operator+(Float4 a, Float4 b) { return { vaddq_f32(a.v, b.v) }; }
+inline Float4 operator-(Float4 a, Float4 b) { return { vsubq_f32(a.v, b.v) }; }
+inline Float4 operator*(Float4 a, Float4 b) { return { vmulq_f32(a.v, b.v) }; }
+inline Float4 operator/(Float4 a, Float4 b) { return { vdivq_f32(a.v, b.v) }; }
+inline Float4 min(Float4 a, Float4 b) { return { vminq_f32(a.v, b.v) }; }
+inline Float4 max(Float4 a, Float4 b) { return { vmaxq_f32(a.v, b.v) }; }
+inline Float4 sqrt(Float4 a) { return { vsqrtq_f32(a.v) }; }
+
+inline Float4 greaterThan(Float4 a, Float4 b) {
+  return { vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)) };
+}
+
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+  return { vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v) };
+}
+
+inline bool any(Float4 mask) { return vmaxvq_u32(vreinterpretq_u32_f32(mask.v)) != 0; }
+
+inline int bitMask(Float4 mask) {
+  static const uint32_t kBits[4] = { 1, 2, 4, 8 };
+  return (int)vaddvq_u32(vandq_u32(vreinterpretq_u32_f32(mask.v), vld1q_u32(kBits)));
+}
+
+inline float lane0(Float4 a) { return vgetq_lane_f32(a.v, 0); }
+
+// vrecpe / vrsqrte는 상대 오차 약 2^-8이라 vrecps / vrsqrts로 한 번 다듬어 SSE2 추정값(2^-12)보다 낫게 맞춘다
+// (fastmath의 Newton 1회 뒤 오차가 플랫폼과 무관하게 문서 범위 안)
+inline Float4 rcpEstimate(Float4 a) {
+  const float32x4_t r = vrecpeq_f32(a.v);
+  return { vmulq_f32(r, vrecpsq_f32(a.v, r)) };
+}
+
+inline Float4 rsqrtEstimate(Float4 a) {
+  const float32x4_t r = vrsqrteq_f32(a.v);
+  return { vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a.v, r), r)) };
+}
+
+inline Float4 truncate(Float4 a) { return { vcvtq_f32_s32(vcvtq_s32_f32(a.v)) }; }
+
+inline Float4 exp2Integer(Float4 n) {
+  int32x4_t e = vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127));
+  return { vreinterpretq_f32_s32(vshlq_n_s32(e, 23)) };
+}
+
+inline void splitExponent(Float4 x, Float4& exponent, Float4& mantissa) {
+  int32x4_t bits = vreinterpretq_s32_f32(x.v);
+  int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(bits), 23)),
+                          vdupq_n_s32(127));
+  exponent.v = vcvtq_f32_s32(e);
+  mantissa.v = vreinterpretq_f32_s32(vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007FFFFF)),
+                                               vdupq_n_s32(0x3F800000)));
+}
+
+#else
+
+inline Float4 Float4::splat(float s) { return { { s, s, s, s } }; }
+inline Float4 Float4::load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+inline void Float4::store(float* p) const {
+  for (int i = 0; i < 4; ++i) p[i] = v[i];
+}
+
+#define SSR_FLOAT4_BINARY(expr) \
+  Float4 r; \
+  for (int i = 0; i < 4; ++i) r.v[i] = (expr); \
+  return r;
+
+inline Float4 operator+(Float4 a, Float4 b) { SSR_FLOAT4_BINARY(a.v[i] + b.v[i]) }
+inline Float4 operator-(Float4 a, Float4 b) { SSR_FLOAT4_BINARY(a.v[i] - b.v[i]) }
+inline Float4 operator*(Float4 a, Float4 b) { SSR_FLOAT4_BINARY(a.v[i] * b.v[i]) }
+inline Float4 operator/(Float4 a, Float4 b) { SSR_FLOAT4_BINARY(a.v[i] / b.v[i]) }
+inline Float4 min(Float4 a, Float4 b) { SSR_FLOAT4_BINARY(a.v[i] < b.v[i] ? a.v[i] : b.v[i]) }
+inline Float4 max(Float4 a, Float4 b) { SSR_FLOAT4_BINARY(a.v[i] > b.v[i] ? a.v[i] : b.v[i]) }
+inline Float4 sqrt(Float4 a) { SSR_FLOAT4_BINARY(std::sqrt(a.v[i])) }
+
+// 스칼라 경로에서는 마스크를 0.0 / 1.0 이 아닌 "0이 아닌 값"으로 표현
+inline Float4 greaterThan(Float4 a, Float4 b) { SSR_FLOAT4_BINARY(a.v[i] > b.v[i] ? 1.0f : 0.0f) }
+
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+  Float4 r;
+  for (int i = 0; i < 4; ++i) r.v[i] = (mask.v[i] != 0.0f) ? a.v[i] : b.v[i];
+  return r;
+}
+
+inline bool any(Float4 mask) {
+  return mask.v[0] != 0.0f || mask.v[1] != 0.0f || mask.v[2] != 0.0f || mask.v[3] != 0.0f;
+}
+
+inline int bitMask(Float4 mask) {
+  return (mask.v[0] != 0.0f ? 1 : 0) | (mask.v[1] != 0.0f ? 2 : 0) |
+         (mask.v[2] != 0.0f ? 4 : 0) | (mask.v[3] != 0.0f ? 8 : 0);
+}
+
+inline float lane0(Float4 a) { return a.v[0]; }
+
+// 스칼라 경로에는 추정 명령이 없으므로 정확한 값을 돌려준다 (Newton 단계는 그대로 수렴)
+inline Float4 rcpEstimate(Float4 a) { SSR_FLOAT4_BINARY(1.0f / a.v[i]) }
+inline Float4 rsqrtEstimate(Float4 a) { SSR_FLOAT4_BINARY(1.0f / std::sqrt(a.v[i])) }
+inline Float4 truncate(Float4 a) { SSR_FLOAT4_BINARY(std::trunc(a.v[i])) }
+inline Float4 exp2Integer(Float4 n) { SSR_FLOAT4_BINARY(std::ldexp(1.0f, (int)n.v[i])) }
+
+inline void splitExponent(Float4 x, Float4& exponent, Float4& mantissa) {
+  for (int i = 0; i < 4; ++i) {
+    int e = 0;
+    // frexp는 [0.5, 1) 기준이므로 [1, 2)로 맞춤
+    mantissa.v[i] = std::frexp(x.v[i], &e) * 2.0f;
+    exponent.v[i] = (float)(e - 1);
+  }
+}
+
+#undef SSR_FLOAT4_BINARY
+
+#endif
+
+inline Float4 clamp01(Float4 a) {
+  return min(max(a, Float4::splat(0.0f)), Float4::splat(1.0f));
+}
+
+/// @brief SoA 형태로 나뉜 3차원 벡터 4개의 내적
+inline Float4 dot3(Float4 ax, Float4 ay, Float4 az, Float4 bx, Float4 by, Float4 bz) {
+  return ax * bx + ay * by + az * bz;
+}
+
+}  // namespace ssr
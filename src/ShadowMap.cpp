@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+// File: ShadowMap.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "ShadowMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SIMD.hpp"
+
+namespace ssr {
+
+void ShadowMap::resize(int size) {
+  m_size = size;
+  m_depth.assign((size_t)size * size, 1.0f);
+}
+
+void ShadowMap::setupDirectional(const Vector3& lightDirection, const Vector3& center, float radius) {
+  Vector3 dir = lightDirection.normalize();
+  Vector3 eye = center - dir * (radius * 2.0f);
+
+  // 빛이 거의 수직으로 내리쬐면 up 벡터와 평행해지므로 다른 축을 사용
+  Vector3 up = std::fabs(dir.y) > 0.99f ? Vector3{ 0.0f, 0.0f, 1.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+
+  Matrix4x4 view = Matrix4x4::identity;
+  math::setupCameraMatrix(view, eye, center, up);
+
+  // eye에서 center까지 2r 이므로 [r, 3r] 구간이 구 전체를 덮는다
+  Matrix4x4 projection = Matrix4x4::identity;
+  math::setupOrthographicProjectionMatrix(projection, -radius, radius, -radius, radius,
+                                          radius, radius * 3.0f);
+
+  m_lightViewProj = view * projection;
+  m_texelWorldSize = (m_size > 0) ? (2.0f * radius / (float)m_size) : 0.0f;
+}
+
+void ShadowMap::clear() {
+  std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+}
+
+void ShadowMap::renderDepth(const Vector3* worldPositions, size_t vertexCount,
+                            const uint32_t* indices, size_t indexCount) {
+  if (m_size <= 0) {
+    return;
+  }
+
+  // 직교 투영이라 w = 1, 원근 나눗셈이 필요 없다
+  m_lightSpace.resize(vertexCount);
+  const float size = (float)m_size;
+  for (size_t i = 0; i < vertexCount; ++i) {
+    Vector4 p = { worldPositions[i].x, worldPositions[i].y, worldPositions[i].z, 1.0f };
+    p = m_lightViewProj * p;
+    m_lightSpace[i] = { (p.x * 0.5f + 0.5f) * size, (0.5f - p.y * 0.5f) * size, p.z };
+  }
+
+  // 그림자 맵은 양면을 모두 그린다 (얇은 메시나 뒷면이 빛을 받는 경우 대비)
+  for (size_t idx = 0; idx + 2 < indexCount; idx += 3) {
+    rasterizeDepthTriangle(m_lightSpace[indices[idx]],
+                           m_lightSpace[indices[idx + 1]],
+                           m_lightSpace[indices[idx + 2]]);
+  }
+}
+
+void ShadowMap::rasterizeDepthTriangle(const Vector3& a, const Vector3& b, const Vector3& c) {
+  // 에지 함수 e(p) = (p.x - v0.x) * (v1.y - v0.y) - (p.y - v0.y) * (v1.x - v0.x)
+  float area = (c.x - a.x) * (b.y - a.y) - (c.y - a.y) * (b.x - a.x);
+  if (std::fabs(area) < 1e-8f) {
+    return;
+  }
+
+  int minX = std::max(0, (int)std::floor(std::min({ a.x, b.x, c.x })));
+  int minY = std::max(0, (int)std::floor(std::min({ a.y, b.y, c.y })));
+  int maxX = std::min(m_size - 1, (int)std::ceil(std::max({ a.x, b.x, c.x })));
+  int maxY = std::min(m_size - 1, (int)std::ceil(std::max({ a.y, b.y, c.y })));
+  if (minX > maxX || minY > maxY) {
+    return;
+  }
+
+  // 감기 순서와 관계없이 내부가 양수가 되도록 부호를 맞춤
+  const float sign = area > 0.0f ? 1.0f : -1.0f;
+  const float invArea = 1.0f / std::fabs(area);
+
+  // e = A * x + B * y + C 형태로 풀어서 x, y 방향 증분만으로 순회
+  const float a0 = (c.y - b.y) * sign, b0 = -(c.x - b.x) * sign;
+  const float a1 = (a.y - c.y) * sign, b1 = -(a.x - c.x) * sign;
+  const float a2 = (b.y - a.y) * sign, b2 = -(b.x - a.x) * sign;
+  const float c0 = -(a0 * b.x + b0 * b.y);
+  const float c1 = -(a1 * c.x + b1 * c.y);
+  const float c2 = -(a2 * a.x + b2 * a.y);
+
+  // 깊이는 화면 공간에서 선형 (평면 방정식)
+  const float dzdx = (a0 * a.z + a1 * b.z + a2 * c.z) * invArea;
+  const float dzdy = (b0 * a.z + b1 * b.z + b2 * c.z) * invArea;
+  const float z00 = (c0 * a.z + c1 * b.z + c2 * c.z) * invArea;
+
+  const float startX = (float)minX + 0.5f;
+  for (int y = minY; y <= maxY; ++y) {
+    const float py = (float)y + 0.5f;
+    float e0 = a0 * startX + b0 * py + c0;
+    float e1 = a1 * startX + b1 * py + c1;
+    float e2 = a2 * startX + b2 * py + c2;
+    float z = z00 + dzdx * startX + dzdy * py;
+
+    float* row = m_depth.data() + (size_t)y * m_size;
+    for (int x = minX; x <= maxX; ++x) {
+      if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && z < row[x]) {
+        row[x] = z;
+      }
+      e0 += a0;
+      e1 += a1;
+      e2 += a2;
+      z += dzdx;
+    }
+  }
+}
+
+void ShadowMap::visibility4(const float* x, const float* y, const float* z, float* out) const {
+  if (m_size <= 0) {
+    std::fill(out, out + 4, 1.0f);
+    return;
+  }
+
+  // 4개 지점을 한 번에 광원 공간으로 변환
+  const Matrix4x4& m = m_lightViewProj;
+  const Float4 px = Float4::load(x), py = Float4::load(y), pz = Float4::load(z);
+  const Float4 half = Float4::splat(0.5f);
+  const Float4 size = Float4::splat((float)m_size);
+  Float4 lx = px * Float4::splat(m.m11) + py * Float4::splat(m.m21) + pz * Float4::splat(m.m31) + Float4::splat(m.m41);
+  Float4 ly = px * Float4::splat(m.m12) + py * Float4::splat(m.m22) + pz * Float4::splat(m.m32) + Float4::splat(m.m42);
+  Float4 lz = px * Float4::splat(m.m13) + py * Float4::splat(m.m23) + pz * Float4::splat(m.m33) + Float4::splat(m.m43);
+
+  float u[4], v[4], d[4];
+  ((lx * half + half) * size).store(u);
+  ((half - ly * half) * size).store(v);
+  (lz - Float4::splat(depthBias)).store(d);
+
+  for (int i = 0; i < 4; ++i) {
+    // 맵 밖이나 far 평면 뒤는 빛을 받는 것으로 처리
+    if (u[i] < 0.0f || v[i] < 0.0f || u[i] >= (float)m_size || v[i] >= (float)m_size || d[i] > 1.0f) {
+      out[i] = 1.0f;
+      continue;
+    }
+
+    const int tx = (int)u[i];
+    const int ty = (int)v[i];
+    int lit = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+      const int sy = std::min(std::max(ty + dy, 0), m_size - 1);
+      const float* row = m_depth.data() + (size_t)sy * m_size;
+      for (int dx = -1; dx <= 1; ++dx) {
+        const int sx = std::min(std::max(tx + dx, 0), m_size - 1);
+        lit += (d[i] <= row[sx]) ? 1 : 0;
+      }
+    }
+    out[i] = (float)lit * (1.0f / 9.0f);
+  }
+}
+
+}  // namespace ssr
@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+// File: ShadowMap.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Math.hpp"
+
+namespace ssr {
+
+/// @brief 방향광 시점의 깊이 전용 렌더 타깃
+/// 메인 래스터라이저(drawTexturedTriangle)와 달리 텍스처 샘플링, 색 기록, uv 보간이 없는
+/// 깊이 전용 커널로 그린다. 라이팅 단계에서 PCF로 샘플링한다.
+class ShadowMap {
+public:
+  void resize(int size);
+
+  /// @brief 방향광이 center를 중심으로 한 반지름 radius 구를 모두 덮도록 직교 투영 구성
+  void setupDirectional(const Vector3& lightDirection, const Vector3& center, float radius);
+
+  void clear();
+
+  /// @brief 월드 좌표 삼각형 목록을 깊이 맵에 그림. clear() 이후 메시마다 호출
+  void renderDepth(const Vector3* worldPositions, size_t vertexCount,
+                   const uint32_t* indices, size_t indexCount);
+
+  /// @brief 월드 좌표 4개의 가시도 [0, 1] (3x3 PCF). 0이면 완전히 그림자
+  void visibility4(const float* x, const float* y, const float* z, float* out) const;
+
+  /// @brief 자기 그림자 여드름(shadow acne)을 막기 위해 노멀 방향으로 밀어낼 거리
+  float normalOffset() const { return m_texelWorldSize * 1.5f; }
+
+  int size() const { return m_size; }
+
+  const float* depth() const { return m_depth.data(); }
+
+  float depthBias = 0.002f;
+
+private:
+  // 깊이 전용 삼각형 커널. 화면 좌표(텍셀 단위)와 깊이
+  void rasterizeDepthTriangle(const Vector3& a, const Vector3& b, const Vector3& c);
+
+  int m_size = 0;
+  float m_texelWorldSize = 0.0f;
+  Matrix4x4 m_lightViewProj = Matrix4x4::identity;
+  std::vector<Vector3> m_lightSpace;
+  std::vector<float> m_depth;
+};
+
+}  // namespace ssr
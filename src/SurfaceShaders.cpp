@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+// File: SurfaceShaders.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "SurfaceShaders.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ColorSpace.hpp"
+
+namespace ssr {
+
+namespace surface {
+
+namespace {
+
+// 물: 부드러운 큰 물결, 불: 잘게 끊기는 불꽃. 두 볼륨 모두 시간 축으로 한 바퀴 돌면 처음과 이어진다
+NoiseVolume g_waterNoise;
+NoiseVolume g_fireNoise;
+
+const float kWaterLoopSeconds = 12.0f;
+const float kFireLoopSeconds = 3.0f;
+
+float saturate(float x) {
+  return std::min(std::max(x, 0.0f), 1.0f);
+}
+
+// [0, 1) 로 감싼 시간 좌표
+float loopTime(float time, float loopSeconds) {
+  float t = time / loopSeconds;
+  return t - std::floor(t);
+}
+
+bool shadeWater(float u, float v, float time, SurfaceSample& out) {
+  const float t = loopTime(time, kWaterLoopSeconds);
+
+  // 서로 다른 방향으로 흘러가는 두 겹. 첫 번째 겹의 기울기로 노멀을 흔든다
+  const float su = u * 2.0f + time * 0.03f;
+  const float sv = v * 2.0f + time * 0.015f;
+  const float eps = 1.0f / (float)g_waterNoise.size();
+  const float h = g_waterNoise.sample(su, sv, t);
+  const float hx = g_waterNoise.sample(su + eps, sv, t);
+  const float hz = g_waterNoise.sample(su, sv + eps, t);
+  const float detail = g_waterNoise.sample(u * 5.0f - time * 0.05f, v * 5.0f + 0.37f, t + 0.5f);
+
+  // 텍셀 한 칸 차이를 표면 기울기로 사용 (크기는 눈으로 맞춘 값)
+  out.slopeX = (h - hx) * 6.0f;
+  out.slopeZ = (h - hz) * 6.0f;
+
+  // 골은 짙은 청록, 마루는 밝은 물색
+  const float crest = saturate((h * 0.7f + detail * 0.3f - 0.35f) * 2.5f);
+  out.r = 0.02f + 0.18f * crest;
+  out.g = 0.16f + 0.34f * crest;
+  out.b = 0.30f + 0.35f * crest;
+  out.alpha = 0.85f;
+  return true;
+}
+
+bool shadeFire(float u, float v, float time, SurfaceSample& out) {
+  const float t = loopTime(time, kFireLoopSeconds);
+
+  // 불꽃이 위로 올라가도록 v 방향으로 흘림. v = 0 위쪽, v = 1 바닥
+  const float n = g_fireNoise.sample(u * 1.5f, v * 1.2f + time * 0.45f, t);
+
+  // 바닥 가운데가 가장 뜨겁고 위와 옆으로 갈수록 식는다
+  const float side = 1.0f - std::fabs(u - 0.5f) * 2.0f;
+  const float heat = n * 1.6f * v * side * (0.6f + 0.4f * v) - 0.12f;
+  if (heat <= 0.02f) {
+    return false;
+  }
+
+  // 검정 -> 빨강 -> 주황 -> 노랑 그라디언트
+  out.r = saturate(heat * 3.0f);
+  out.g = saturate(heat * 3.0f - 0.9f);
+  out.b = saturate(heat * 3.0f - 2.0f);
+  out.alpha = saturate(heat * 2.5f);
+  return true;
+}
+
+}  // namespace
+
+void initNoise() {
+  if (g_waterNoise.empty()) {
+    g_waterNoise.generate(64, 32, 4, 2, 3, 0x5EA5EA5Eu);
+  }
+  if (g_fireNoise.empty()) {
+    g_fireNoise.generate(64, 32, 4, 4, 4, 0xF12EF12Eu);
+  }
+}
+
+bool shade(SurfaceType type, float u, float v, float time, SurfaceSample& out) {
+  bool visible = true;
+  switch (type) {
+  case SurfaceType::Water: visible = shadeWater(u, v, time, out); break;
+  case SurfaceType::Fire: visible = shadeFire(u, v, time, out); break;
+  case SurfaceType::Textured: return true;
+  }
+  // 색 상수는 텍스처처럼 화면(sRGB) 기준으로 정했으므로 라이팅 전에 선형으로 변환
+  if (visible && srgb::enabled()) {
+    out.r = srgb::decode((uint8_t)(out.r * 255.0f + 0.5f));
+    out.g = srgb::decode((uint8_t)(out.g * 255.0f + 0.5f));
+    out.b = srgb::decode((uint8_t)(out.b * 255.0f + 0.5f));
+  }
+  return visible;
+}
+
+}  // namespace surface
+
+}  // namespace ssr
@@ -0,0 +1,34 @@
+//------------------------------------------------------------------------------
+// File: SurfaceShaders.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Lighting.hpp"
+#include "Noise.hpp"
+
+namespace ssr {
+
+/// @brief 래스터라이저가 픽셀마다 알베도 대신 채워 넣는 표면 셰이더 결과
+struct SurfaceSample {
+  float r = 1.0f, g = 1.0f, b = 1.0f;
+  float alpha = 1.0f;
+  // 월드 노멀에 더할 기울기 (수평면 기준 x, z). ShadingFrequency::Pixel 에서만 사용
+  float slopeX = 0.0f, slopeZ = 0.0f;
+};
+
+namespace surface {
+
+/// @brief 물/불 셰이더가 공유하는 노이즈 볼륨 생성 (시작 시 한 번)
+void initNoise();
+
+/// @brief SurfaceType::Water, Fire 표면 셰이딩. 반환값이 false면 픽셀을 버린다 (알파 테스트)
+/// uv는 원근 보정된 텍스처 좌표, time은 초 단위 씬 시간
+bool shade(SurfaceType type, float u, float v, float time, SurfaceSample& out);
+
+}  // namespace surface
+
+}  // namespace ssr
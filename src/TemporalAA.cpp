@@ -0,0 +1,241 @@
+//------------------------------------------------------------------------------
+// File: TemporalAA.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "TemporalAA.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ColorSpace.hpp"
+#include "FrameBuffer.hpp"
+#include "ThreadPool.hpp"
+
+namespace ssr {
+
+namespace {
+
+// Halton 수열 주기. 8개면 픽셀 안을 고르게 덮고 주기가 짧아 수렴이 빠르다
+constexpr uint32_t kJitterPeriod = 8;
+// 재투영 위치가 정수 픽셀에 이만큼 가까우면 이중선형 대신 그대로 읽음
+// (카메라가 멈춰 있을 때 부동소수 오차로 매 프레임 조금씩 흐려지는 것 방지)
+constexpr float kSnapEpsilon = 1e-3f;
+
+float halton(uint32_t index, uint32_t base) {
+  float result = 0.0f;
+  float fraction = 1.0f / (float)base;
+  while (index > 0) {
+    result += (float)(index % base) * fraction;
+    index /= base;
+    fraction /= (float)base;
+  }
+  return result;
+}
+
+}  // namespace
+
+void TemporalAA::resize(int width, int height) {
+  if (m_width == width && m_height == height) {
+    return;
+  }
+  m_width = width;
+  m_height = height;
+  const size_t size = (size_t)width * height;
+  m_currentR.assign(size, 0.0f);
+  m_currentG.assign(size, 0.0f);
+  m_currentB.assign(size, 0.0f);
+  for (int i = 0; i < 2; ++i) {
+    m_historyR[i].assign(size, 0.0f);
+    m_historyG[i].assign(size, 0.0f);
+    m_historyB[i].assign(size, 0.0f);
+  }
+  m_historyValid = false;
+}
+
+Vector2 TemporalAA::nextJitter() {
+  // 0번은 (0, 0)이 되므로 1부터 시작
+  const uint32_t index = m_frameIndex % kJitterPeriod + 1;
+  ++m_frameIndex;
+  return { halton(index, 2) - 0.5f, halton(index, 3) - 0.5f };
+}
+
+void TemporalAA::applyJitter(Matrix4x4& projection, const Vector2& jitter, int width, int height) {
+  // row-vector 규약에서 clip.x += z_view * m31 이고 clip.w = z_view 이므로 NDC x가 m31만큼 이동
+  // 뷰포트는 y를 뒤집으므로 화면 아래쪽(+y) 이동은 NDC -y
+  projection.m31 += 2.0f * jitter.x / (float)width;
+  projection.m32 -= 2.0f * jitter.y / (float)height;
+}
+
+void TemporalAA::decodeRows(const uint32_t* pixels, int pitchInPixels, int y0, int y1, bool linear) {
+  for (int y = y0; y < y1; ++y) {
+    const uint32_t* src = pixels + (size_t)y * pitchInPixels;
+    const size_t row = (size_t)y * m_width;
+    for (int x = 0; x < m_width; ++x) {
+      const uint32_t c = src[x];
+      m_currentR[row + x] = srgb::toWorking(c >> 16, linear);
+      m_currentG[row + x] = srgb::toWorking(c >> 8, linear);
+      m_currentB[row + x] = srgb::toWorking(c, linear);
+    }
+  }
+}
+
+void TemporalAA::rowRange(int y, float* minPlanes, float* maxPlanes) const {
+  const float* current[3] = { m_currentR.data(), m_currentG.data(), m_currentB.data() };
+  const size_t row = (size_t)y * m_width;
+  for (int c = 0; c < 3; ++c) {
+    const float* src = current[c] + row;
+    float* outMin = minPlanes + (size_t)c * m_width;
+    float* outMax = maxPlanes + (size_t)c * m_width;
+    // 양 끝은 가장자리 픽셀을 반복한 것으로 보고, 안쪽은 분기 없이 돌려서 벡터화되게 한다
+    const int last = m_width - 1;
+    outMin[0] = std::min(src[0], src[1]);
+    outMax[0] = std::max(src[0], src[1]);
+    for (int x = 1; x < last; ++x) {
+      outMin[x] = std::min(std::min(src[x - 1], src[x]), src[x + 1]);
+      outMax[x] = std::max(std::max(src[x - 1], src[x]), src[x + 1]);
+    }
+    outMin[last] = std::min(src[last - 1], src[last]);
+    outMax[last] = std::max(src[last - 1], src[last]);
+  }
+}
+
+void TemporalAA::resolveRows(uint32_t* pixels, int pitchInPixels, const FrameBuffer& target,
+                             const Matrix4x4& reprojection, int y0, int y1, bool linear) {
+  const int width = m_width;
+  const int height = m_height;
+  const int write = m_read ^ 1;
+  const bool historyValid = m_historyValid;
+  const float weight = currentWeight;
+  const float* history[3] = { m_historyR[m_read].data(), m_historyG[m_read].data(),
+                              m_historyB[m_read].data() };
+  float* out[3] = { m_historyR[write].data(), m_historyG[write].data(), m_historyB[write].data() };
+  const float* current[3] = { m_currentR.data(), m_currentG.data(), m_currentB.data() };
+  const float ndcStepX = 2.0f / (float)width;
+  const float ndcStepY = 2.0f / (float)height;
+  const size_t planeSize = (size_t)3 * width;
+
+  // 3x3 이웃 범위는 가로 3칸 범위를 3행 링 버퍼에 두고 세로로 합친다 (분리 가능한 min / max)
+  std::vector<float> rangeMin(3 * planeSize), rangeMax(3 * planeSize);
+  auto ringSlot = [&](int y) { return (size_t)(y % 3) * planeSize; };
+  for (int y = std::max(y0 - 1, 0); y < std::min(y0 + 1, height); ++y) {
+    rowRange(y, rangeMin.data() + ringSlot(y), rangeMax.data() + ringSlot(y));
+  }
+
+  // 행 단위로 재투영 결과를 먼저 구해 두고 채널별로 섞는다
+  // sampleIndex < 0 이면 히스토리 없음 (첫 프레임, 화면 밖, 카메라 뒤)
+  std::vector<int> sampleIndex(width);
+  std::vector<float> weights(4 * (size_t)width);
+
+  for (int y = y0; y < y1; ++y) {
+    if (y + 1 < height) {
+      rowRange(y + 1, rangeMin.data() + ringSlot(y + 1), rangeMax.data() + ringSlot(y + 1));
+    }
+    const size_t up = ringSlot(std::max(y - 1, 0));
+    const size_t mid = ringSlot(y);
+    const size_t down = ringSlot(std::min(y + 1, height - 1));
+    const size_t row = (size_t)y * width;
+
+    // 1. 재투영: 현재 픽셀 중심과 깊이로 이전 프레임 화면 좌표를 구함
+    // 행렬을 NDC x에 대해 펼쳐서 행 안에서는 x, z 항만 더한다
+    const float ndcY = 1.0f - (y + 0.5f) * ndcStepY;
+    const float rowX = ndcY * reprojection.m21 + reprojection.m41;
+    const float rowY = ndcY * reprojection.m22 + reprojection.m42;
+    const float rowW = ndcY * reprojection.m24 + reprojection.m44;
+    for (int x = 0; x < width; ++x) {
+      sampleIndex[x] = -1;
+      if (!historyValid) {
+        continue;
+      }
+      const float z = target.nearestDepth(x, y);
+      const float ndcX = (x + 0.5f) * ndcStepX - 1.0f;
+      const float clipX = ndcX * reprojection.m11 + z * reprojection.m31 + rowX;
+      const float clipY = ndcX * reprojection.m12 + z * reprojection.m32 + rowY;
+      const float clipW = ndcX * reprojection.m14 + z * reprojection.m34 + rowW;
+      if (clipW <= 0.0f) {
+        continue;
+      }
+      const float invW = 1.0f / clipW;
+      const float prevX = (clipX * invW * 0.5f + 0.5f) * width - 0.5f;
+      const float prevY = (0.5f - clipY * invW * 0.5f) * height - 0.5f;
+      if (!(prevX >= 0.0f && prevY >= 0.0f && prevX <= (float)(width - 1) && prevY <= (float)(height - 1))) {
+        continue;
+      }
+      // 범위 검사를 통과했으므로 음수가 아니고, 정수 변환이 floor 호출보다 싸다
+      const int hx = std::min((int)prevX, width - 2);
+      const int hy = std::min((int)prevY, height - 2);
+      float fx = prevX - (float)hx;
+      float fy = prevY - (float)hy;
+      // 정수 픽셀에 붙으면 가중치를 0 / 1로 맞춰서 그대로 읽음
+      fx = fx < kSnapEpsilon ? 0.0f : (fx > 1.0f - kSnapEpsilon ? 1.0f : fx);
+      fy = fy < kSnapEpsilon ? 0.0f : (fy > 1.0f - kSnapEpsilon ? 1.0f : fy);
+      sampleIndex[x] = hy * width + hx;
+      float* w = &weights[4 * (size_t)x];
+      w[0] = (1.0f - fx) * (1.0f - fy);
+      w[1] = fx * (1.0f - fy);
+      w[2] = (1.0f - fx) * fy;
+      w[3] = fx * fy;
+    }
+
+    // 2. 채널별로 히스토리를 이중선형 샘플링 -> 3x3 이웃 범위로 자름 -> 지수 이동 평균
+    for (int c = 0; c < 3; ++c) {
+      const float* cur = current[c] + row;
+      const float* hist = history[c];
+      const size_t plane = (size_t)c * width;
+      const float* minUp = rangeMin.data() + up + plane;
+      const float* minMid = rangeMin.data() + mid + plane;
+      const float* minDown = rangeMin.data() + down + plane;
+      const float* maxUp = rangeMax.data() + up + plane;
+      const float* maxMid = rangeMax.data() + mid + plane;
+      const float* maxDown = rangeMax.data() + down + plane;
+      float* dst = out[c] + row;
+      for (int x = 0; x < width; ++x) {
+        const int h = sampleIndex[x];
+        if (h < 0) {
+          dst[x] = cur[x];
+          continue;
+        }
+        const float* w = &weights[4 * (size_t)x];
+        const float sampled = hist[h] * w[0] + hist[h + 1] * w[1] +
+                              hist[h + width] * w[2] + hist[h + width + 1] * w[3];
+        const float lo = std::min(std::min(minUp[x], minMid[x]), minDown[x]);
+        const float hi = std::max(std::max(maxUp[x], maxMid[x]), maxDown[x]);
+        const float clamped = std::min(std::max(sampled, lo), hi);
+        dst[x] = clamped + (cur[x] - clamped) * weight;
+      }
+    }
+
+    // 3. 새 히스토리를 프레임버퍼 형식으로 기록 (알파는 유지)
+    uint32_t* dst = pixels + (size_t)y * pitchInPixels;
+    const float* outR = out[0] + row;
+    const float* outG = out[1] + row;
+    const float* outB = out[2] + row;
+    for (int x = 0; x < width; ++x) {
+      dst[x] = (dst[x] & 0xFF000000u) | (srgb::fromWorking(outR[x], linear) << 16) |
+               (srgb::fromWorking(outG[x], linear) << 8) | srgb::fromWorking(outB[x], linear);
+    }
+  }
+}
+
+void TemporalAA::resolve(uint32_t* pixels, int pitchInPixels, const FrameBuffer& target,
+                         const Matrix4x4& viewProjection, ThreadPool& pool) {
+  const bool linear = srgb::enabled();
+
+  // 현재 NDC -> 월드 -> 이전 클립 공간을 한 행렬로 (row-vector 규약이라 왼쪽부터 적용)
+  const Matrix4x4 reprojection = viewProjection.inverse() * m_prevViewProjection;
+
+  pool.parallelFor(m_height, ThreadPool::kRowBand, [&](int y0, int y1) {
+    decodeRows(pixels, pitchInPixels, y0, y1, linear);
+  });
+  pool.parallelFor(m_height, ThreadPool::kRowBand, [&](int y0, int y1) {
+    resolveRows(pixels, pitchInPixels, target, reprojection, y0, y1, linear);
+  });
+
+  m_read ^= 1;
+  m_prevViewProjection = viewProjection;
+  m_historyValid = true;
+}
+
+}  // namespace ssr
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+// File: TemporalAA.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Math.hpp"
+
+namespace ssr {
+
+class FrameBuffer;
+class ThreadPool;
+
+/// @brief 시간 축 안티에일리어싱 (TAA)
+/// 매 프레임 투영 행렬을 Halton(2, 3) 수열만큼 서브픽셀 이동시켜 그리고, 이전 프레임까지 누적한
+/// 히스토리를 현재 깊이로 재투영해서 섞는다. 움직이는 물체의 잔상은 현재 프레임 3x3 이웃의
+/// 색 범위로 히스토리를 잘라서(neighbourhood clamp) 줄인다.
+/// 카메라가 멈춰 있으면 여러 프레임에 걸쳐 픽셀 안의 여러 위치를 샘플링한 것과 같아진다.
+class TemporalAA {
+public:
+  void resize(int width, int height);
+
+  /// @brief 히스토리를 버리고 다음 프레임부터 다시 누적
+  void reset() { m_historyValid = false; }
+
+  /// @brief 이번 프레임의 서브픽셀 이동량 (픽셀 단위, [-0.5, 0.5]). 호출할 때마다 수열이 진행된다
+  Vector2 nextJitter();
+
+  /// @brief 투영 행렬 사본에 화면 공간 이동을 적용 (원근 나눗셈 뒤 NDC에서 상수 이동이 되도록 m31, m32)
+  static void applyJitter(Matrix4x4& projection, const Vector2& jitter, int width, int height);
+
+  /// @brief 현재 프레임(pixels)을 히스토리와 섞어서 제자리에 기록하고 히스토리를 갱신
+  /// @param target 깊이 샘플(NDC z)을 읽을 렌더 타깃. 픽셀마다 샘플 중 가장 가까운 값으로 재투영
+  /// @param viewProjection 이번 프레임의 지터가 없는 카메라 * 투영 행렬
+  void resolve(uint32_t* pixels, int pitchInPixels, const FrameBuffer& target,
+               const Matrix4x4& viewProjection, ThreadPool& pool);
+
+  /// @brief 현재 프레임 비중. 작을수록 부드럽지만 변화에 늦게 반응한다
+  float currentWeight = 0.1f;
+
+private:
+  void decodeRows(const uint32_t* pixels, int pitchInPixels, int y0, int y1, bool linear);
+  /// @brief y행의 가로 3칸 min / max (R, G, B 평면 순서로 너비만큼씩)
+  void rowRange(int y, float* minPlanes, float* maxPlanes) const;
+  void resolveRows(uint32_t* pixels, int pitchInPixels, const FrameBuffer& target,
+                   const Matrix4x4& reprojection, int y0, int y1, bool linear);
+
+  int m_width = 0;
+  int m_height = 0;
+  uint32_t m_frameIndex = 0;
+  bool m_historyValid = false;
+  Matrix4x4 m_prevViewProjection = Matrix4x4::identity;
+
+  // 현재 프레임 색 (작업 공간 float). 이웃 범위 계산용
+  std::vector<float> m_currentR, m_currentG, m_currentB;
+  // 히스토리는 두 벌을 번갈아 읽고 쓴다 (이중선형 샘플링이 이웃을 읽으므로 제자리 갱신 불가)
+  std::vector<float> m_historyR[2], m_historyG[2], m_historyB[2];
+  int m_read = 0;
+};
+
+}  // namespace ssr
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+// File: ThreadPool.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace ssr {
+
+ThreadPool::ThreadPool(int threadCount) {
+  if (threadCount <= 0) {
+    threadCount = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+  }
+  m_workers.reserve(threadCount);
+  for (int i = 0; i < threadCount; ++i) {
+    m_workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallelFor(int count, int grain, const std::function<void(int, int)>& fn) {
+  if (count <= 0) {
+    return;
+  }
+  grain = std::max(1, grain);
+
+  // 작업 스레드가 없거나 조각이 하나면 바로 실행
+  if (m_workers.empty() || count <= grain) {
+    for (int begin = 0; begin < count; begin += grain) {
+      fn(begin, std::min(count, begin + grain));
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_job = &fn;
+    m_count = count;
+    m_grain = grain;
+    m_next.store(0, std::memory_order_relaxed);
+    m_busyWorkers = (int)m_workers.size();
+    ++m_generation;
+  }
+  m_wake.notify_all();
+
+  runChunks();
+
+  // 모든 작업 스레드가 조각을 다 처리하고 m_job을 놓을 때까지 대기
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+  m_job = nullptr;
+}
+
+void ThreadPool::runChunks() {
+  for (;;) {
+    const int begin = m_next.fetch_add(m_grain, std::memory_order_relaxed);
+    if (begin >= m_count) {
+      break;
+    }
+    (*m_job)(begin, std::min(m_count, begin + m_grain));
+  }
+}
+
+void ThreadPool::workerLoop() {
+  unsigned seenGeneration = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [&] { return m_stop || m_generation != seenGeneration; });
+      if (m_stop) {
+        return;
+      }
+      seenGeneration = m_generation;
+    }
+
+    runChunks();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      --m_busyWorkers;
+    }
+    m_done.notify_one();
+  }
+}
+
+}  // namespace ssr
@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+// File: ThreadPool.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ssr {
+
+/// @brief 후처리 패스의 행 단위 작업(row band)을 나눠 돌리는 고정 크기 스레드 풀
+/// 작업은 한 번에 하나의 parallelFor만 받는다. 호출한 스레드도 일을 나눠 가지므로
+/// 코어가 하나뿐이면 작업 스레드 없이 그 자리에서 순서대로 실행한다.
+class ThreadPool {
+public:
+  /// @brief 후처리 패스(TAA, FXAA, 픽셀 패스 묶음)가 화면 크기 평면을 parallelFor로 나눌 때의 행 수
+  /// 작업 스레드가 여럿일 때 조각이 충분히 나오고 조각마다의 준비(행 버퍼, 목록 할당)가 잦지 않은 정도
+  static constexpr int kRowBand = 32;
+
+  /// @brief threadCount가 0이면 hardware_concurrency - 1개 (호출 스레드 몫을 뺌)
+  explicit ThreadPool(int threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief [0, count)를 grain개씩 잘라 fn(begin, end)를 병렬로 호출하고 모두 끝나면 반환
+  /// 조각이 실행되는 순서와 스레드는 정해져 있지 않다
+  void parallelFor(int count, int grain, const std::function<void(int, int)>& fn);
+
+  /// @brief 호출 스레드를 포함한 동시 실행 수
+  int concurrency() const { return (int)m_workers.size() + 1; }
+
+private:
+  void workerLoop();
+  void runChunks();
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+
+  // 현재 작업. m_generation이 바뀌면 작업 스레드가 깨어나서 조각을 가져간다
+  const std::function<void(int, int)>* m_job = nullptr;
+  int m_count = 0;
+  int m_grain = 1;
+  std::atomic<int> m_next{ 0 };
+  int m_busyWorkers = 0;
+  unsigned m_generation = 0;
+  bool m_stop = false;
+};
+
+}  // namespace ssr
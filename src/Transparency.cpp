@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+// File: Transparency.cpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#include "Transparency.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#include "Blend.hpp"
+#include "ColorSpace.hpp"
+
+namespace ssr {
+
+void WeightedBlendedOIT::resize(int width, int height) {
+  m_width = width;
+  m_height = height;
+  const size_t size = (size_t)width * height;
+  m_accumR.assign(size, 0.0f);
+  m_accumG.assign(size, 0.0f);
+  m_accumB.assign(size, 0.0f);
+  m_accumA.assign(size, 0.0f);
+  m_revealage.assign(size, 1.0f);
+  m_rowMinX.assign(height, INT_MAX);
+  m_rowMaxX.assign(height, -1);
+  m_resolveRow.resize(width);
+}
+
+void WeightedBlendedOIT::setDepthRange(float zNear, float zFar, bool reversedZ) {
+  m_zNear = zNear;
+  m_zFar = zFar;
+  m_reversedZ = reversedZ;
+}
+
+float WeightedBlendedOIT::weight(float ndcDepth, float alpha) const {
+  // NDC z(0~1)는 near 쪽에 몰려 있어 가중치로 쓰기 어려우므로 뷰 공간 깊이로 되돌린다
+  // z_ndc = f / (f - n) - f * n / ((f - n) * z_view)
+  if (m_reversedZ) {
+    ndcDepth = 1.0f - ndcDepth;
+  }
+  const float range = m_zFar - m_zNear;
+  const float viewZ = (m_zFar * m_zNear) / std::max(m_zFar - ndcDepth * range, 1e-6f);
+
+  // 논문 식 (7): 가까운 층일수록 큰 가중치
+  const float a = viewZ * 0.2f;
+  const float b = viewZ * (1.0f / 200.0f);
+  const float b3 = b * b * b;
+  const float w = 10.0f / (1e-5f + a * a + b3 * b3);
+  return alpha * std::min(std::max(w, 1e-2f), 3e3f);
+}
+
+void WeightedBlendedOIT::accumulate(const lighting::FragmentBatch& batch, bool premultiplied) {
+  // 감마 보정이 켜져 있으면 셰이딩 결과(sRGB)를 선형으로 되돌려서 누적
+  const bool linear = srgb::enabled();
+  for (int i = 0; i < batch.count; ++i) {
+    const uint32_t color = batch.color[i];
+    const float alpha = (color >> 24) * (1.0f / 255.0f);
+    if (alpha <= 0.0f) {
+      continue;
+    }
+
+    const uint32_t pixel = batch.pixel[i];
+    const float w = weight(batch.depth[i], alpha);
+    // 스트레이트 알파면 c * a * w, 프리멀티플라이드면 이미 c * a 이므로 a를 뺀 가중치만 곱함
+    const float colorScale = premultiplied ? w / alpha : w;
+    if (linear) {
+      m_accumR[pixel] += srgb::decode((uint8_t)(color >> 16)) * colorScale;
+      m_accumG[pixel] += srgb::decode((uint8_t)(color >> 8)) * colorScale;
+      m_accumB[pixel] += srgb::decode((uint8_t)color) * colorScale;
+    } else {
+      m_accumR[pixel] += ((color >> 16) & 0xFF) * (colorScale * (1.0f / 255.0f));
+      m_accumG[pixel] += ((color >> 8) & 0xFF) * (colorScale * (1.0f / 255.0f));
+      m_accumB[pixel] += (color & 0xFF) * (colorScale * (1.0f / 255.0f));
+    }
+    m_accumA[pixel] += w;
+    m_revealage[pixel] *= 1.0f - alpha;
+
+    const int y = (int)(pixel / (uint32_t)m_width);
+    const int x = (int)(pixel - (uint32_t)y * m_width);
+    m_rowMinX[y] = std::min(m_rowMinX[y], x);
+    m_rowMaxX[y] = std::max(m_rowMaxX[y], x);
+  }
+}
+
+void WeightedBlendedOIT::composite(uint32_t* frameBuffer, int pitchInPixels) {
+  const bool linear = srgb::enabled();
+  for (int y = 0; y < m_height; ++y) {
+    const int x0 = m_rowMinX[y];
+    const int x1 = m_rowMaxX[y];
+    if (x0 > x1) {
+      continue;
+    }
+
+    // 평균 색 = Σ(c a w) / Σ(a w), 커버리지 = 1 - Π(1 - a)
+    // 이를 스트레이트 알파 픽셀로 만들어 Blend::span(Alpha)로 한 번에 합성
+    // 감마 보정 중이면 평균 색을 sRGB로 인코드하고 합성도 선형 공간(spanSrgb)에서
+    const size_t rowStart = (size_t)y * m_width;
+    for (int x = x0; x <= x1; ++x) {
+      const size_t i = rowStart + x;
+      const float invWeight = 1.0f / std::max(m_accumA[i], 1e-5f);
+      const float r = std::min(m_accumR[i] * invWeight, 1.0f);
+      const float g = std::min(m_accumG[i] * invWeight, 1.0f);
+      const float b = std::min(m_accumB[i] * invWeight, 1.0f);
+      const uint32_t a = (uint32_t)((1.0f - m_revealage[i]) * 255.0f + 0.5f);
+      uint32_t rgb;
+      if (linear) {
+        rgb = ((uint32_t)srgb::encode(r) << 16) | ((uint32_t)srgb::encode(g) << 8) | srgb::encode(b);
+      } else {
+        rgb = ((uint32_t)(r * 255.0f + 0.5f) << 16) | ((uint32_t)(g * 255.0f + 0.5f) << 8) |
+              (uint32_t)(b * 255.0f + 0.5f);
+      }
+      m_resolveRow[x] = (a << 24) | rgb;
+    }
+    uint32_t* dst = frameBuffer + (size_t)y * pitchInPixels + x0;
+    if (linear) {
+      Blend::spanSrgb(BlendMode::Alpha, m_resolveRow.data() + x0, dst, (size_t)(x1 - x0 + 1));
+    } else {
+      Blend::span(BlendMode::Alpha, m_resolveRow.data() + x0, dst, (size_t)(x1 - x0 + 1));
+    }
+
+    // 사용한 범위만 다음 프레임을 위해 비움
+    std::fill(m_accumR.begin() + rowStart + x0, m_accumR.begin() + rowStart + x1 + 1, 0.0f);
+    std::fill(m_accumG.begin() + rowStart + x0, m_accumG.begin() + rowStart + x1 + 1, 0.0f);
+    std::fill(m_accumB.begin() + rowStart + x0, m_accumB.begin() + rowStart + x1 + 1, 0.0f);
+    std::fill(m_accumA.begin() + rowStart + x0, m_accumA.begin() + rowStart + x1 + 1, 0.0f);
+    std::fill(m_revealage.begin() + rowStart + x0, m_revealage.begin() + rowStart + x1 + 1, 1.0f);
+    m_rowMinX[y] = INT_MAX;
+    m_rowMaxX[y] = -1;
+  }
+}
+
+}  // namespace ssr
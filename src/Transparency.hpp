@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+// File: Transparency.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Lighting.hpp"
+
+namespace ssr {
+
+/// @brief Weighted Blended Order-Independent Transparency (McGuire & Bavoil 2013)
+/// 반투명 프래그먼트를 그리는 순서와 관계없이 누적 버퍼(가중 프리멀티플라이드 색, 가중 알파)와
+/// revealage 버퍼(Π(1 - a))에 모은 뒤 composite()에서 한 번에 프레임버퍼 위에 합성한다.
+/// 삼각형 정렬이 필요 없는 대신 겹친 층의 앞뒤 관계는 깊이 가중치로만 근사한다.
+class WeightedBlendedOIT {
+public:
+  void resize(int width, int height);
+
+  /// @brief 깊이 가중치에 쓸 뷰 공간 깊이 복원용 (원근 투영의 near / far)
+  /// @param reversedZ 깊이를 뒤집은 투영 (near = 1, far = 0)
+  void setDepthRange(float zNear, float zFar, bool reversedZ = false);
+
+  /// @brief 셰이딩이 끝난 배치를 누적. premultiplied면 color의 RGB에 이미 알파가 곱해져 있다
+  void accumulate(const lighting::FragmentBatch& batch, bool premultiplied);
+
+  /// @brief 누적 결과를 프레임버퍼(0xAARRGGBB)에 알파 블렌딩하고 사용한 영역을 다음 프레임용으로 비움
+  void composite(uint32_t* frameBuffer, int pitchInPixels);
+
+private:
+  float weight(float ndcDepth, float alpha) const;
+
+  int m_width = 0;
+  int m_height = 0;
+  float m_zNear = 0.1f;
+  float m_zFar = 10.0f;
+  bool m_reversedZ = false;
+
+  // 누적 버퍼 (SoA): Σ(c * a * w), Σ(a * w)
+  std::vector<float> m_accumR, m_accumG, m_accumB, m_accumA;
+  // Π(1 - a). 1이면 아무것도 덮지 않음
+  std::vector<float> m_revealage;
+
+  // 행마다 이번 프레임에 누적된 x 범위. composite와 비우기를 이 범위로 한정한다
+  std::vector<int> m_rowMinX, m_rowMaxX;
+  std::vector<uint32_t> m_resolveRow;
+};
+
+}  // namespace ssr
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+// File: TripleBuffer.hpp
+// Author: Chris Redwood
+// Created: 2026-10-18
+// License: MIT License
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include "FrameBuffer.hpp"
+
+namespace ssr {
+
+/// @brief 렌더 스레드(생산자) 하나와 출력 스레드(소비자) 하나가 완성된 프레임을 주고받는 잠금 없는 트리플 버퍼
+/// 프레임 세 장을 생산자 몫(back), 가운데(middle), 소비자 몫(front)으로 나눠 쥔다.
+/// publish는 back과 middle을, acquire는 front와 middle을 원자적으로 맞바꾸므로 어느 쪽도 기다리지 않는다.
+/// 소비자가 느리면 가운데 프레임이 새 프레임으로 덮이고 (가장 최근 것만 출력), 생산자가 느리면 acquire가 false를 돌려준다.
+/// 소비자가 할 일이 없을 때는 waitForFresh로 잠들 수 있다 (publish가 깨움. 프레임 교환 자체는 여전히 잠금 없음).
+/// 출력 속도가 정해져 있으면 생산자도 waitForConsumed로 소비자가 가져갈 때까지 잠들어 덮어쓸 프레임을 그리지 않는다 (acquire가 깨움).
+class TripleBuffer {
+public:
+  /// @brief 리졸브된 1x 색 한 장 (0xAARRGGBB, 행 우선, 한 행 width개)
+  struct Frame {
+    AlignedArray<uint32_t> pixels;
+    int width = 0;
+    int height = 0;
+    /// 생산자가 매긴 프레임 번호. 소비자가 건너뛴 프레임 수를 셀 때 쓴다
+    uint64_t index = 0;
+
+    void resize(int w, int h) {
+      pixels.allocate((size_t)w * h);
+      width = w;
+      height = h;
+    }
+  };
+
+  /// @brief 생산자가 다음에 채울 프레임. publish 전까지 생산자만 만진다 (크기가 바뀌면 resize)
+  Frame& writeFrame() { return m_frames[m_back]; }
+
+  /// @brief writeFrame을 소비자에게 넘기고 새 writeFrame을 받는다
+  void publish() {
+    m_back = m_middle.exchange((uint8_t)(m_back | kFresh), std::memory_order_acq_rel) & kIndexMask;
+    // 소비자가 비트를 확인하고 잠드는 사이에 알림을 놓치지 않도록 잠금을 한 번 거친다
+    { std::lock_guard<std::mutex> lock(m_signalMutex); }
+    m_published.notify_one();
+  }
+
+  /// @brief 새로 publish된 프레임이 생길 때까지 최대 timeout 기다린다 (소비자). 생겼으면 true, 가져오는 것은 acquire
+  template <class Rep, class Period>
+  bool waitForFresh(std::chrono::duration<Rep, Period> timeout) {
+    std::unique_lock<std::mutex> lock(m_signalMutex);
+    return m_published.wait_for(lock, timeout, [this] {
+      return (m_middle.load(std::memory_order_relaxed) & kFresh) != 0;
+    });
+  }
+
+  /// @brief 마지막으로 publish한 프레임을 소비자가 가져갈 때까지 최대 timeout 기다린다 (생산자). 가져갔으면 true
+  template <class Rep, class Period>
+  bool waitForConsumed(std::chrono::duration<Rep, Period> timeout) {
+    std::unique_lock<std::mutex> lock(m_signalMutex);
+    return m_consumed.wait_for(lock, timeout, [this] {
+      return (m_middle.load(std::memory_order_relaxed) & kFresh) == 0;
+    });
+  }
+
+  /// @brief 마지막 acquire 이후 새로 publish된 프레임이 있으면 readFrame으로 가져오고 true
+  bool acquire() {
+    if ((m_middle.load(std::memory_order_relaxed) & kFresh) == 0) {
+      return false;
+    }
+    m_front = m_middle.exchange((uint8_t)m_front, std::memory_order_acq_rel) & kIndexMask;
+    // publish와 같은 이유로 잠금을 한 번 거친다
+    { std::lock_guard<std::mutex> lock(m_signalMutex); }
+    m_consumed.notify_one();
+    return true;
+  }
+
+  /// @brief 소비자가 가진 프레임. 다음 acquire 전까지 소비자만 만진다
+  const Frame& readFrame() const { return m_frames[m_front]; }
+
+private:
+  static constexpr uint8_t kIndexMask = 0x3;
+  static constexpr uint8_t kFresh = 0x4;
+
+  Frame m_frames[3];
+  // back / front는 각자의 스레드만 읽고 쓴다. 가운데 인덱스와 "새 프레임" 비트만 두 스레드가 공유
+  int m_back = 0;
+  int m_front = 1;
+  std::atomic<uint8_t> m_middle{ 2 };
+  std::mutex m_signalMutex;
+  std::condition_variable m_published;
+  std::condition_variable m_consumed;
+};
+
+}  // namespace ssr